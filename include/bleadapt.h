@@ -0,0 +1,16 @@
+#ifndef _BLEADAPT_H
+#define _BLEADAPT_H
+
+#include <esp_gap_ble_api.h>
+
+#include "globals.h"
+#include "bleduty.h"
+
+void bleadapt_start(void);
+void bleadapt_restart(void);
+void bleadapt_discovered(void);
+bool bleadapt_event(esp_gap_ble_cb_event_t event,
+                    esp_ble_gap_cb_param_t *param);
+void bleadapt_status(uint16_t *window, uint16_t *interval, uint16_t *duty);
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef _BLEDUTY_H
+#define _BLEDUTY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Adaptive BLE scan duty cycle. Once per epoch the number of newly discovered
+// devices decides the duty level: an epoch without discoveries halves the
+// duty, alternately by narrowing the scan window and by widening the scan
+// interval, until both bounds are reached. A burst of discoveries returns to
+// full duty at once, a single discovery doubles it. The duty is integrated
+// over time, so the mean duty of a period can be reported.
+
+#define BLEDUTY_MAX_LEVEL 16 // upper limit of duty levels
+
+class BleDuty {
+public:
+  // times in [ms], widen is the number of new devices per epoch which
+  // restores full duty
+  BleDuty(uint16_t window, uint16_t interval, uint16_t minwindow,
+          uint16_t maxinterval, uint16_t widen);
+
+  bool update(uint32_t newdevs, uint32_t elapsed); // true if duty changed
+  void reset(void);
+
+  uint16_t window(void) const { return win; }
+  uint16_t interval(void) const { return ival; }
+  uint8_t level(void) const { return lvl; }
+  uint16_t duty(void) const;     // [per mille]
+  uint16_t meanDuty(void) const; // [per mille] since last resetMean()
+  void resetMean(void);
+
+private:
+  void apply(void);
+  void step(int8_t dir);
+
+  uint16_t win0, ival0, winmin, ivalmax, widen;
+  uint8_t lvl, maxlvl;
+  uint16_t win, ival;
+  uint64_t dutytime; // integral of duty [per mille x ms]
+  uint32_t time;     // [ms] since last resetMean()
+};
+
+#endif
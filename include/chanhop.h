@@ -0,0 +1,54 @@
+#ifndef _CHANHOP_H
+#define _CHANHOP_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Adaptive WiFi channel hopping. Frames and new devices are counted per
+// channel, at the end of each round over all enabled channels the dwell
+// times of the next round are reweighted by the activity rate of each
+// channel. Rates are normalized by the time spent on a channel, so a busy
+// channel does not win just because it was listened to longer. A share of
+// each round is spread evenly over all channels, so quiet channels are
+// still explored, and all dwell times stay within min/max.
+
+#define CHANHOP_CHANNELS 13   // 2.4GHz channels 1..13
+#define CHANHOP_NEW_WEIGHT 16 // a new device counts as much as this many frames
+#define CHANHOP_EWMA_SHIFT 2  // weight of last round is 1/2^CHANHOP_EWMA_SHIFT
+
+struct ChanHopStats {
+  uint32_t frames;  // frames since last stats reset
+  uint32_t newdevs; // new devices since last stats reset
+  uint32_t rate;    // smoothed activity per second
+  uint16_t dwell;   // current dwell time [ms]
+};
+
+class ChanHop {
+public:
+  // chanmap bit 0 is channel 1, dwell times in [ms], explore in percent
+  ChanHop(uint16_t chanmap, uint16_t dwell, uint16_t mindwell,
+          uint16_t maxdwell, uint8_t explore);
+
+  void setup(uint16_t chanmap, uint16_t dwell); // resets all statistics
+  void record(uint8_t channel, bool isnew);
+  uint8_t next(uint16_t *dwell); // switch to next channel, 0 if none enabled
+  uint8_t channel(void) const { return cur; }
+  const ChanHopStats *stats(uint8_t channel) const;
+  void resetStats(void); // clears frame and device counters only
+  uint16_t channels(void) const { return map; }
+
+private:
+  void reweight(void);
+
+  uint16_t map;
+  uint16_t base, lo, hi;
+  uint8_t explore;
+  uint8_t cur;     // current channel, 0 before first hop
+  uint32_t rounds; // completed rounds
+  ChanHopStats st[CHANHOP_CHANNELS];
+  uint32_t frames[CHANHOP_CHANNELS]; // frames of current round
+  uint32_t newdevs[CHANHOP_CHANNELS]; // new devices of current round
+  uint32_t listened[CHANHOP_CHANNELS]; // time on channel this round [ms]
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef _COUNTFILTER_H
+#define _COUNTFILTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Scalar Kalman filter smoothing device counts of successive send cycles.
+// The true count is modelled as a random walk drifting by a fraction of the
+// count per minute, a measured count is noisy with a variance proportional
+// to the count. In steady state this is an EWMA whose weight follows the
+// ratio of both noises. A long gap between updates, e.g. deep sleep, widens
+// the variance so the next measurement is taken nearly as is. The state is
+// a plain struct owned by the caller, so it can live in RTC memory.
+
+#define COUNTFILTER_MAGIC 0x4b464331 // marks a valid state
+#define COUNTFILTER_Z95 1.96f        // two sided 95% quantile of normal
+
+typedef struct {
+  uint32_t magic; // COUNTFILTER_MAGIC if x and p are valid
+  uint32_t last;  // [seconds] time of last update
+  float x;        // smoothed count
+  float p;        // variance of x
+} countFilterState_t;
+
+class CountFilter {
+public:
+  // drift [percent per minute] of the true count, noise [percent] measurement
+  // variance relative to the count, 100 is Poisson noise
+  CountFilter(countFilterState_t *state, uint16_t drift, uint16_t noise);
+
+  // feeds count measured at now [seconds] with additional known variance,
+  // returns smoothed count
+  float update(uint32_t count, uint32_t now, float variance = 0);
+  float value(void) const { return s->x; }
+  float interval(void) const; // half width of 95% confidence interval
+  void reset(void);
+
+private:
+  countFilterState_t *s;
+  float q; // process variance per minute, relative to squared count
+  float r; // measurement variance, relative to count
+};
+
+#endif
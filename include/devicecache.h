@@ -0,0 +1,98 @@
+#ifndef _DEVICECACHE_H
+#define _DEVICECACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// Fixed size, set associative cache for per device state. A key selects one
+// set of WAYS entries, so lookup and insert touch at most WAYS entries. When
+// a set is full, the entry seen least recently in that set is evicted.
+// Key 0 marks a free entry, callers pass a well mixed 64 bit device key.
+
+template <typename T, uint32_t SETS, uint8_t WAYS = 4> class DeviceCache {
+  static_assert(SETS && !(SETS & (SETS - 1)), "SETS must be power of 2");
+
+public:
+  struct Entry {
+    uint64_t key;
+    uint32_t first; // timestamp of first sighting
+    uint32_t last;  // timestamp of last sighting
+    T value;
+  };
+
+  DeviceCache() { clear(); }
+
+  void clear(void) {
+    memset(entry, 0, sizeof(entry));
+    used = 0;
+    evicted = 0;
+  }
+
+  // returns entry for key, inserts a new one if key is unknown
+  Entry *lookup(uint64_t key, uint32_t now, bool *isnew = NULL) {
+    key = key ? key : 1;
+    Entry *set = entry + (uint32_t)(key >> 32) % SETS * WAYS;
+    Entry *victim = set;
+
+    for (uint8_t w = 0; w < WAYS; w++) {
+      if (set[w].key == key) {
+        set[w].last = now;
+        if (isnew)
+          *isnew = false;
+        return set + w;
+      }
+      if (!victim->key)
+        continue; // keep first free entry as victim
+      if (!set[w].key || ((int32_t)(set[w].last - victim->last) < 0))
+        victim = set + w;
+    }
+
+    if (victim->key)
+      evicted++;
+    else
+      used++;
+    memset(victim, 0, sizeof(Entry));
+    victim->key = key;
+    victim->first = now;
+    victim->last = now;
+    if (isnew)
+      *isnew = true;
+    return victim;
+  }
+
+  // returns entry for key or NULL, does not touch timestamps
+  Entry *find(uint64_t key) {
+    key = key ? key : 1;
+    Entry *set = entry + (uint32_t)(key >> 32) % SETS * WAYS;
+    for (uint8_t w = 0; w < WAYS; w++)
+      if (set[w].key == key)
+        return set + w;
+    return NULL;
+  }
+
+  void remove(Entry *e) {
+    if (e && e->key) {
+      e->key = 0;
+      used--;
+    }
+  }
+
+  // calls f(Entry &) for all used entries
+  template <typename F> void forEach(F f) {
+    for (uint32_t i = 0; i < SETS * WAYS; i++)
+      if (entry[i].key)
+        f(entry[i]);
+  }
+
+  uint32_t size(void) const { return used; }
+  uint32_t capacity(void) const { return SETS * WAYS; }
+  uint32_t evictions(void) const { return evicted; }
+
+private:
+  Entry entry[SETS * WAYS];
+  uint32_t used;
+  uint32_t evicted;
+};
+
+#endif
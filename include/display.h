@@ -8,7 +8,7 @@
 #include "power.h"
 #include "timekeeper.h"
 
-#define DISPLAY_PAGES (7) // number of paxcounter display pages
+#define DISPLAY_PAGES (8) // number of paxcounter display pages
 #define PLOTBUFFERSIZE (MY_DISPLAY_WIDTH * MY_DISPLAY_HEIGHT / 8)
 #define QR_VERSION 3 // 29 x 29px
 
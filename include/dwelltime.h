@@ -0,0 +1,21 @@
+#ifndef _DWELLTIME_H
+#define _DWELLTIME_H
+
+#include "globals.h"
+#include "devicecache.h"
+#include "macdedup.h"
+
+typedef struct {
+  uint16_t devices; // number of devices evaluated
+  uint16_t p50;     // median dwell time [seconds]
+  uint16_t p90;     // 90th percentile dwell time [seconds]
+} dwellStatus_t;
+
+#define DWELL_ENTRIES (4 * DWELL_TABLE_SETS) // devices held by dwell table
+
+void dwell_add(uint64_t key, uint32_t now);
+void dwell_clear(void);
+// times is scratch space of DWELL_ENTRIES owned by the calling task
+void dwell_percentiles(dwellStatus_t *dwell, uint32_t since, uint16_t *times);
+
+#endif
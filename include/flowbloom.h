@@ -0,0 +1,47 @@
+#ifndef _FLOWBLOOM_H
+#define _FLOWBLOOM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Arrivals and departures between two intervals from a pair of Bloom
+// filters, one for the current and one for the previous interval. A device
+// new in the current interval is an arrival if the previous one misses it,
+// departures are the devices of the previous interval not seen again. At
+// the interval end the filters swap roles, so memory is constant. False
+// positives of the filters bias both numbers slightly low.
+
+#define FLOWBLOOM_HASHES 3 // bits per device
+
+class FlowBloom {
+public:
+  // words holds 2 * nbits / 32 words, nbits must be a power of 2 >= 32
+  FlowBloom(uint32_t *words, uint32_t nbits);
+
+  void add(uint64_t hash); // hash must be a well mixed 64 bit value
+  void rotate(uint32_t *arrivals, uint32_t *departures); // ends interval
+  void clear(void);
+  uint32_t devices(void) const { return unique; } // in current interval
+
+private:
+  bool insert(uint32_t *set, uint64_t hash);
+  bool contains(const uint32_t *set, uint64_t hash) const;
+
+  uint32_t *cur, *prev;
+  uint32_t mask;     // nbits - 1
+  uint32_t nwords;   // per filter
+  uint32_t unique;   // devices in current interval
+  uint32_t arrived;  // devices in current, not in previous interval
+  uint32_t previous; // devices in previous interval
+};
+
+// convenience wrapper owning its filters
+template <uint32_t BITS> class StaticFlowBloom : public FlowBloom {
+public:
+  StaticFlowBloom() : FlowBloom(storage, BITS) {}
+
+private:
+  uint32_t storage[2 * BITS / 32];
+};
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef _FRAMETYPE_H
+#define _FRAMETYPE_H
+
+#include "globals.h"
+#include "hyperloglog.h"
+
+// Breakdown of detections by frame type. Phones scanning for networks send
+// probe requests and connectable advertisements, while static IoT devices
+// mostly send data frames and non-connectable beacons. Per class we count
+// frames and estimate unique devices with a small sketch, both reset each
+// time the breakdown is read.
+
+enum frameClass_t {
+  FRAME_WIFI_PROBE,    // wifi probe request
+  FRAME_WIFI_OTHER,    // wifi data and other management frames
+  FRAME_BLE_CONN,      // connectable ble advertisement
+  FRAME_BLE_NONCONN,   // scannable or non-connectable ble advertisement
+  FRAME_BLE_SCANRSP,   // ble scan response
+  FRAME_CLASSES
+};
+
+typedef struct {
+  uint16_t frames[FRAME_CLASSES];
+  uint16_t devices[FRAME_CLASSES];
+} frameStats_t;
+
+void frame_add(uint64_t key, uint8_t cls);
+void frame_stats(frameStats_t *stats);
+void frame_reset(void);
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef _GENBLOOM_H
+#define _GENBLOOM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Generational Bloom filter counting devices seen in a sliding time window.
+// Each cell holds the stamp of the generation which touched it last, so a
+// device is in the window while all of its cells carry a stamp of the last
+// ngen generations. Expired generations fade out one at a time, thus the
+// count moves smoothly instead of dropping to zero at a cycle reset.
+// Cells expire by the age of their stamp, a new generation only frees a
+// small share of them, so stamps can't wrap around to look fresh again.
+// Inserts touch GENBLOOM_HASHES cells, memory is one byte per cell.
+
+#define GENBLOOM_HASHES 3      // number of cells per device
+#define GENBLOOM_MAX_GEN 16    // maximum number of generations
+#define GENBLOOM_CLASSES 2     // separately counted device classes
+#define GENBLOOM_STAMPS 255    // stamps cycle 1..255, 0 marks an empty cell
+// generations to free all expired cells once, stamps must not wrap meanwhile
+#define GENBLOOM_SCRUB (GENBLOOM_STAMPS - GENBLOOM_MAX_GEN)
+
+class GenBloom {
+public:
+  GenBloom(uint8_t *cells, uint32_t ncells, uint8_t generations,
+           uint32_t window);
+
+  bool add(uint64_t hash, uint32_t now, uint8_t cls = 0); // true if new
+  uint32_t count(uint32_t now, uint8_t cls);
+  uint32_t count(uint32_t now); // all classes
+  void setWindow(uint32_t window); // [seconds] covered by all generations
+  void clear(void);
+
+private:
+  void advance(uint32_t now);
+  void tick(void);
+  uint8_t age(uint8_t s) const {
+    return (uint8_t)((stamp + GENBLOOM_STAMPS - s) % GENBLOOM_STAMPS);
+  }
+
+  uint8_t *cell;
+  uint32_t m;
+  uint8_t ngen;
+  uint32_t len;   // generation length [seconds]
+  uint32_t epoch; // now / len of current generation
+  uint8_t stamp;  // stamp of current generation
+  uint8_t gen;    // ring index of current generation in fresh[]
+  uint32_t scrub; // next cell checked for expiry
+  // number of devices whose most recent sighting is in a generation
+  uint32_t fresh[GENBLOOM_CLASSES][GENBLOOM_MAX_GEN];
+};
+
+// convenience wrapper owning its cells
+template <uint32_t CELLS> class StaticGenBloom : public GenBloom {
+public:
+  StaticGenBloom(uint8_t generations, uint32_t window)
+      : GenBloom(storage, CELLS, generations, window) {}
+
+private:
+  uint8_t storage[CELLS];
+};
+
+#endif
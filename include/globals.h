@@ -24,7 +24,7 @@
 
 // bits in payloadmask for filtering payload data
 #define COUNT_DATA _bit(0)
-#define RESERVED_DATA _bit(1)
+#define FRAMES_DATA _bit(1)
 #define MEMS_DATA _bit(2)
 #define GPS_DATA _bit(3)
 #define SENSOR1_DATA _bit(4)
@@ -51,6 +51,16 @@
 
 enum snifftype_t { MAC_SNIFF_WIFI, MAC_SNIFF_BLE, MAC_SNIFF_BLE_ENS };
 
+// occupancy estimator coefficients, see paxestimate.cpp
+#define PAX_COEFS 5
+#define PAX_COEF_OFFSET 0 // persons
+#define PAX_COEF_WIFI 1   // per wifi device
+#define PAX_COEF_BLE 2    // per ble device
+#define PAX_COEF_NEAR 3   // per device in near rssi band
+#define PAX_COEF_RANDOM 4 // per device with randomized MAC
+
+#define RSSI_ZONES 4 // rssi band thresholds, see rssi_zones()
+
 // Struct holding devices's runtime configuration
 // using packed to avoid compiler padding, because struct will be memcpy'd to
 // byte array
@@ -61,7 +71,8 @@ typedef struct __attribute__((packed)) {
   uint8_t adrmode;       // 0=disabled, 1=enabled
   uint8_t screensaver;   // 0=disabled, 1=enabled
   uint8_t screenon;      // 0=disabled, 1=enabled
-  uint8_t countermode; // 0=cyclic unconfirmed, 1=cumulative, 2=cyclic confirmed
+  uint8_t countermode; // 0=cyclic unconfirmed, 1=cumulative, 2=cyclic
+                       // confirmed, 3=cumulative sketch
   int16_t rssilimit;   // threshold for rssilimiter, negative value!
   uint8_t sendcycle;   // payload send cycle [seconds/2]
   uint16_t sleepcycle; // sleep cycle [seconds/10]
@@ -74,6 +85,9 @@ typedef struct __attribute__((packed)) {
   uint8_t wifiant;       // 0=internal, 1=external (for LoPy/LoPy4)
   uint8_t rgblum;        // RGB Led luminosity (0..100%)
   uint8_t payloadmask;   // bitswitches for payload data
+  int16_t paxcoef[PAX_COEFS]; // occupancy estimator coefficients [1/256]
+  int8_t rssizone[RSSI_ZONES]; // zone thresholds [dBm], 0=unused
+  uint8_t sitekey[16];         // key of exported sketches, same site wide
 
 #ifdef HAS_BME680
   uint8_t
@@ -0,0 +1,15 @@
+#ifndef _HISTORY_H
+#define _HISTORY_H
+
+#include <libpax_api.h>
+
+#include "globals.h"
+#include "hourhistory.h"
+
+// Hourly aggregates of the counts of the last HISTORY_HOURS hours, kept in
+// RAM, so a backend can fill gaps after a gateway outage by rcommand.
+
+void history_add(const struct count_payload_t *count);
+void history_send(uint8_t first, uint8_t hours);
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef _HOURHISTORY_H
+#define _HOURHISTORY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Ring of hourly aggregates (min, max, mean) of a few counts. Samples are
+// added with the number of the hour they belong to, a new hour closes the
+// current record. Hours skipped, e.g. while the device was asleep, are kept
+// as empty records (min > max), so the ring always covers consecutive
+// hours. A clock jumping backwards or far ahead just starts a new hour.
+
+#define HISTORY_SERIES 3 // pax, wifi, ble
+
+typedef struct {
+  uint16_t min[HISTORY_SERIES];
+  uint16_t max[HISTORY_SERIES];
+  uint16_t mean[HISTORY_SERIES];
+} histRecord_t;
+
+class HourHistory {
+public:
+  // slab holds hours records, the oldest is overwritten when full
+  HourHistory(histRecord_t *slab, uint16_t hours);
+
+  void add(uint32_t hour, const uint16_t value[HISTORY_SERIES]);
+  bool get(uint16_t ago, histRecord_t *rec) const; // 0 = current hour
+  uint16_t held(void) const { return count; } // hours, including current
+  void clear(void);
+
+private:
+  void advance(uint16_t hours);
+
+  histRecord_t *rec;
+  uint16_t n;
+  uint16_t head;  // index of current hour
+  uint16_t count; // records held
+  uint32_t hour;  // number of current hour
+  uint32_t sum[HISTORY_SERIES];
+  uint16_t samples; // in current hour
+};
+
+// records of recsize bytes to put behind a one byte age into a packet, at
+// most what the payload buffer of capacity bytes holds. An uplink of
+// maxpayload bytes too small for one record still gets one, the buffer never
+// gets more than it holds, so 0 if even one does not fit.
+uint8_t history_records(uint8_t capacity, uint16_t maxpayload,
+                        uint8_t recsize);
+
+// convenience wrapper owning its records
+template <uint16_t HOURS> class StaticHourHistory : public HourHistory {
+public:
+  StaticHourHistory() : HourHistory(storage, HOURS) {}
+
+private:
+  histRecord_t storage[HOURS];
+};
+
+#endif
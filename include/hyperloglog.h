@@ -0,0 +1,45 @@
+#ifndef _HYPERLOGLOG_H
+#define _HYPERLOGLOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// HyperLogLog cardinality sketch (Flajolet et al. 2007). Estimates the number
+// of distinct items with fixed memory of 2^precision one byte registers and a
+// relative standard error of 1.04 / sqrt(2^precision).
+
+#define HLL_MIN_PRECISION 4
+#define HLL_MAX_PRECISION 16
+
+class HyperLogLog {
+public:
+  // attach = true uses the current content of registers instead of clearing
+  HyperLogLog(uint8_t *registers, uint8_t precision, bool attach = false);
+
+  void add(uint64_t hash); // hash must be a well mixed 64 bit value
+  bool merge(const HyperLogLog &other); // union, needs same precision
+  void clear(void);
+  uint32_t estimate(void) const;
+  float stderror(void) const; // relative standard error of estimate
+  uint8_t precision(void) const { return p; }
+  uint32_t size(void) const { return m; } // number of registers
+
+private:
+  uint8_t *regs;
+  uint8_t p;
+  uint32_t m;
+};
+
+// convenience wrapper owning its registers
+template <uint8_t P> class StaticHyperLogLog : public HyperLogLog {
+  static_assert(P >= HLL_MIN_PRECISION && P <= HLL_MAX_PRECISION,
+                "HLL precision out of range");
+
+public:
+  StaticHyperLogLog() : HyperLogLog(storage, P) {}
+
+private:
+  uint8_t storage[1U << P];
+};
+
+#endif
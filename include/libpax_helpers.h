@@ -5,9 +5,42 @@
 #include <libpax_api.h>
 #include "senddata.h"
 #include "configmanager.h"
+#include "macdedup.h"
+#include "hyperloglog.h"
+#include "slidingwindow.h"
+#include "genbloom.h"
+#include "flowbloom.h"
+#include "rssitrack.h"
+#include "dwelltime.h"
+#include "wifihop.h"
+#include "bleadapt.h"
+#include "liveconfig.h"
+#include "paxestimate.h"
+#include "countfilter.h"
+#include "randmac.h"
+#include "macanon.h"
+#include "stationary.h"
+#include "history.h"
+#include "sketchexport.h"
+
+#define WINDOW_HORIZONS 4 // number of reported windows, see window_count()
 
 void init_libpax(void);
-int8_t getRSSI(void); // Add declaration for getRSSI function
+int8_t getRSSI(void);
+void get_paxcount(struct count_payload_t *count);
+uint32_t sendcycle_start(void);
+void sketch_add(uint64_t hash, snifftype_t sniff_type);
+void sketch_count(struct count_payload_t *count, uint16_t *error);
+void sketch_save(void);
+void sketch_clear(void);
+void window_add(uint64_t hash, uint32_t now);
+void window_count(uint16_t counts[WINDOW_HORIZONS]);
+bool recent_add(uint64_t hash, snifftype_t sniff_type, uint32_t now);
+void recent_count(struct count_payload_t *count);
+void flow_add(uint64_t hash);
+void flow_cycle(uint16_t *arrivals, uint16_t *departures);
+void count_smooth(const struct count_payload_t *count, uint16_t error,
+                  uint16_t *value, uint8_t *ci);
 
 extern struct count_payload_t count_from_libpax; // libpax count storage
 
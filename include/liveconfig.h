@@ -0,0 +1,34 @@
+#ifndef _LIVECONFIG_H
+#define _LIVECONFIG_H
+
+#include <libpax_api.h>
+
+#include "globals.h"
+
+// Sniffer settings in effect. Tuning rcommands change cfg only, the changes
+// are copied here in one step at the next channel hop, so the counters and
+// the send cycle keep running. Callbacks read this copy, never cfg.
+typedef struct {
+  int8_t rssilimit;
+  uint8_t wifiscan;
+  uint8_t blescan;
+  uint16_t wifichanmap;
+  uint8_t wifichancycle;
+  uint8_t blescantime;
+  uint8_t sendcycle;
+  int8_t rssizone[RSSI_ZONES];
+} sniffcfg_t;
+
+extern sniffcfg_t live;
+
+bool live_config(struct libpax_config_t *config);
+void live_init(void);
+void live_begin(void);
+void live_end(void);
+void live_commit(void);
+void live_restart(void);
+bool live_pending(void);
+void live_apply(void);
+void live_sendcycle(void);
+
+#endif
@@ -46,6 +46,7 @@ void myTxCallback(void *pUserData, int fSuccess);
 const char *getSfName(rps_t rps);
 const char *getBwName(rps_t rps);
 const char *getCrName(rps_t rps);
+uint8_t lora_maxpayload(void);
 
 #if (VERBOSE)
 void showLoraKeys(void);
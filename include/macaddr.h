@@ -0,0 +1,14 @@
+#ifndef _MACADDR_H
+#define _MACADDR_H
+
+#include <stdint.h>
+
+// pack 6 byte MAC address (MSB first) into a 48 bit integer, byte by byte so
+// it neither depends on host byte order nor reads beyond the address
+static inline uint64_t mac_to_u64(const uint8_t *paddr) {
+  return ((uint64_t)paddr[0] << 40) | ((uint64_t)paddr[1] << 32) |
+         ((uint64_t)paddr[2] << 24) | ((uint64_t)paddr[3] << 16) |
+         ((uint64_t)paddr[4] << 8) | (uint64_t)paddr[5];
+}
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef _MACANON_H
+#define _MACANON_H
+
+#include "globals.h"
+#include "siphash.h"
+
+// Anonymized device key, a SipHash of the MAC address under a random salt.
+// The salt is held in RTC RAM only, so it survives deep sleep but is never
+// written to flash or sent, and it rotates every ANON_SALT_ROTATE seconds.
+// All per device tables are keyed by it instead of the MAC address.
+// Sketches and bloom filters store no keys, so rotation gains nothing there.
+// They hash under a fixed salt instead, new at cold start only, thus their
+// counts run on through a rotation.
+
+void anon_init(void);
+bool anon_update(void); // true if the salt was rotated
+uint64_t mac_anon(const uint8_t *paddr);
+uint64_t mac_anon_fixed(const uint8_t *paddr);
+
+#endif
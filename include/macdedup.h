@@ -0,0 +1,56 @@
+#ifndef _MACDEDUP_H
+#define _MACDEDUP_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "macaddr.h"
+
+// Open addressing hash set for 48 bit MAC addresses. Keys are stored in a
+// caller provided, fixed size slab, so there is no heap allocation at runtime.
+// Linear probing on a power of two table gives O(1) insert and lookup as long
+// as the fill level stays below MACDEDUP_MAX_LOAD percent.
+
+#define MACDEDUP_MAX_LOAD 75 // [percent] inserts beyond this fill are dropped
+
+// 64 bit finalizer (murmur3 fmix64), spreads adjacent MACs of the same vendor
+static inline uint64_t mac_mix64(uint64_t k) {
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdULL;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+class MacDedup {
+public:
+  MacDedup(uint64_t *slab, uint32_t slots);
+
+  bool insert(uint64_t mac); // true if mac was not yet in the set
+  bool contains(uint64_t mac) const;
+  void clear(void);
+  uint32_t size(void) const { return count; }
+  uint32_t capacity(void) const { return limit; }
+  uint32_t dropped(void) const { return overflow; }
+
+private:
+  uint64_t *keys;
+  uint32_t mask;     // number of slots - 1
+  uint32_t limit;    // maximum number of keys at MACDEDUP_MAX_LOAD
+  uint32_t count;    // number of keys stored
+  uint32_t overflow; // number of inserts rejected because table was full
+};
+
+// convenience wrapper owning its slab, SLOTS must be a power of two
+template <uint32_t SLOTS> class StaticMacDedup : public MacDedup {
+  static_assert(SLOTS && !(SLOTS & (SLOTS - 1)), "SLOTS must be power of 2");
+
+public:
+  StaticMacDedup() : MacDedup(storage, SLOTS) {}
+
+private:
+  uint64_t storage[SLOTS];
+};
+
+#endif
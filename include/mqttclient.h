@@ -15,6 +15,10 @@
 #define MQTT_CLIENTNAME clientId
 #endif
 
+// sketches go to their own topic, so merging services need not filter
+#define MQTT_TOPIC(port)                                                       \
+  (((port) == SKETCHPORT) ? MQTT_SKETCHTOPIC : MQTT_OUTTOPIC)
+
 extern TaskHandle_t mqttTask;
 
 void mqtt_enqueuedata(MessageBuffer_t *message);
@@ -0,0 +1,19 @@
+#ifndef _OUIFILTER_H
+#define _OUIFILTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Vendor classification by the 24 bit OUI of a globally administered MAC.
+// The table is a perfect hash generated from shared/oui.csv at build time,
+// see shared/ouigen.py, so a lookup costs two hashes and one compare.
+
+enum ouiClass_t { OUI_NONE = 0, OUI_INCLUDE = 1, OUI_EXCLUDE = 2 };
+
+uint8_t oui_lookup(uint32_t oui);
+
+static inline uint32_t oui_from_mac(const uint8_t *paddr) {
+  return ((uint32_t)paddr[0] << 16) | ((uint32_t)paddr[1] << 8) | paddr[2];
+}
+
+#endif
@@ -0,0 +1,45 @@
+// generated by shared/ouigen.py from oui.csv, do not edit
+#ifndef _OUITABLE_H
+#define _OUITABLE_H
+
+#include <stdint.h>
+
+#define OUI_BUCKET_BITS 5
+#define OUI_TABLE_BITS 7
+#define OUI_ENTRIES 70
+
+// displacement per bucket
+static const uint16_t oui_disp[32] = {
+        0,     0,     0,     2,     3,     1,     0,     0,
+        0,     0,     1,     4,     3,     0,     0,     2,
+        0,     0,     1,     1,     2,     0,     2,     1,
+        1,     3,     5,     5,    13,     1,     0,     1,
+};
+
+// class << 24 | oui, 0 marks an empty slot
+static const uint32_t oui_table[128] = {
+    0x00000000, 0x00000000, 0x02000E58, 0x00000000, 0x01001B63, 0x02949F3E,
+    0x023C71BF, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x013C2EFF,
+    0x0100E0FC, 0x00000000, 0x01F8A45F, 0x00000000, 0x00000000, 0x00000000,
+    0x015C0A5B, 0x0128CFE9, 0x01F4F5D8, 0x00000000, 0x00000000, 0x0284CCA8,
+    0x00000000, 0x0250C7BF, 0x02A4CF12, 0x02AC67B2, 0x02881544, 0x02001788,
+    0x00000000, 0x00000000, 0x028CAAB5, 0x00000000, 0x013C5AB4, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x02E0286D, 0x00000000, 0x0224A43C,
+    0x023456FE, 0x01286C07, 0x027483C2, 0x00000000, 0x020418D6, 0x00000000,
+    0x02802AA8, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x02240AC4,
+    0x00000000, 0x01F409D8, 0x00000000, 0x02DCA632, 0x02D83ADD, 0x01BC72B1,
+    0x00000000, 0x01640980, 0x0214CC20, 0x00000000, 0x02B4FBE4, 0x0140A6D9,
+    0x0200040E, 0x00000000, 0x02840D8E, 0x00000000, 0x0218B430, 0x022C91AB,
+    0x00000000, 0x02788A20, 0x02687251, 0x02E45F01, 0x02C80E14, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x023CA62F,
+    0x02FCECDA, 0x01001632, 0x02246F28, 0x02F4F26D, 0x014846FB, 0x027828CA,
+    0x00000000, 0x0228CDC1, 0x00000000, 0x023810D5, 0x02ECB5FA, 0x00000000,
+    0x01742344, 0x0200180A, 0x00000000, 0x02E0553D, 0x02641666, 0x027CFF4D,
+    0x018C7712, 0x02C44F33, 0x022462AB, 0x01F0D1A9, 0x02F09FC2, 0x00000000,
+    0x020C8DDB, 0x00000000, 0x00000000, 0x00000000, 0x0230AEA4, 0x00000000,
+    0x00000000, 0x00000000, 0x00000000, 0x0248A6B8, 0x00000000, 0x025CAAFD,
+    0x02E063DA, 0x00000000, 0x00000000, 0x02B827EB, 0x01ACBC32, 0x00000000,
+    0x027C9EBD, 0x00000000,
+};
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef _PAXESTIMATE_H
+#define _PAXESTIMATE_H
+
+#include <libpax_api.h>
+
+#include "globals.h"
+#include "rssitrack.h"
+
+uint16_t pax_estimate(const struct count_payload_t *count, uint32_t since);
+
+#endif
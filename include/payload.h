@@ -4,6 +4,12 @@
 #include "sensor.h"
 #include "sds011read.h"
 #include "gpsread.h"
+#include "dwelltime.h"
+#include "chanhop.h"
+#include "randmac.h"
+#include "frametype.h"
+#include "hourhistory.h"
+#include "sketchcodec.h"
 
 // MyDevices CayenneLPP 1.0 channels for Synamic sensor payload format
 // all payload goes out on LoRa FPort 1
@@ -23,6 +29,21 @@
 #define LPP_AIR_CHANNEL 31
 #define LPP_PARTMATTER10_CHANNEL 32    // particular matter for PM 10
 #define LPP_PARTMATTER25_CHANNEL 33    // particular matter for PM 2.5
+#define LPP_COUNT_ERROR_CHANNEL 34     // standard error of sketch count
+#define LPP_WINDOW_CHANNEL 35          // first of sliding window counts
+#define LPP_RSSI_CHANNEL 39            // first of rssi histogram buckets
+#define LPP_DWELL_CHANNEL 47           // dwell devices, p50, p90
+#define LPP_HOP_CHANNEL 50             // new devices on wifi channel 1..13
+#define LPP_BLEDUTY_CHANNEL 63         // ble scan window, interval, duty
+#define LPP_PAX_ESTIMATE_CHANNEL 66    // occupancy estimate
+#define LPP_SMOOTH_CHANNEL 67          // smoothed count, confidence interval
+#define LPP_RANDMAC_CHANNEL 69         // global, randomized MACs, rotations
+#define LPP_FRAME_CHANNEL 72           // frames, then devices per frame class
+#define LPP_SNIFF_CHANNEL 82           // wifi, ble detections, then drops
+#define LPP_STATION_CHANNEL 86         // tracked, excluded devices, frames
+#define LPP_ZONE_CHANNEL 89            // first of rssi zone counts
+#define LPP_FLOW_CHANNEL 93            // arrivals, departures
+#define LPP_HISTORY_CHANNEL 95         // age, then pax min, max, mean
 
 // MyDevices CayenneLPP 2.0 types for Packed Sensor Payload, not using channels,
 // but different FPorts
@@ -45,9 +66,26 @@ public:
 
   void reset(void);
   uint8_t getSize(void);
+  uint8_t getCapacity(void); // size of buffer
   uint8_t *getBuffer(void);
   void addByte(uint8_t value);
   void addCount(uint16_t value, uint8_t sniffytpe);
+  void addCount(randStatus_t value);
+  void addCountError(uint16_t value);
+  void addPaxEstimate(uint16_t value);
+  void addSmoothedCount(uint16_t value, uint8_t ci);
+  void addFlow(uint16_t arrivals, uint16_t departures);
+  void addWindowCounts(uint16_t counts[], uint8_t n);
+  void addRSSIHistogram(uint16_t hist[], uint8_t n);
+  void addZoneCounts(uint16_t counts[], uint8_t n);
+  void addDwellTime(dwellStatus_t value);
+  void addChannelStats(uint16_t chanmap, ChanHopStats stats[]);
+  void addFrameTypes(frameStats_t stats);
+  void addHistory(uint8_t ago, histRecord_t rec[], uint8_t n);
+  void addSketch(const sketchHeader_t *h, const uint8_t *regs);
+  void addSnifferStats(uint32_t pushed[2], uint32_t dropped[2]);
+  void addStationary(uint16_t tracked, uint16_t excluded, uint32_t frames);
+  void addBLEDuty(uint16_t window, uint16_t interval, uint16_t duty);
   void addConfig(configData_t value);
   void addStatus(uint16_t voltage, uint64_t uptime, float cputemp, uint32_t mem,
                  uint8_t reset0, uint32_t restarts);
@@ -66,12 +104,14 @@ private:
 
 private:
   uint8_t *buffer;
+  uint8_t maxsize;
   uint8_t cursor;
 
 #elif (PAYLOAD_ENCODER == 2) // format packed
 
 private:
   uint8_t *buffer;
+  uint8_t maxsize;
   uint8_t cursor;
   void uintToBytes(uint64_t i, uint8_t byteSize);
   void writeUptime(uint64_t unixtime);
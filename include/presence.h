@@ -0,0 +1,47 @@
+#ifndef _PRESENCE_H
+#define _PRESENCE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Continuous presence per device in a compact, set associative table of 8
+// byte entries. A device seen without a gap longer than gap minutes
+// accumulates presence time, once it reaches threshold minutes it is
+// excluded until it has been gone for UINT8_MAX minutes. When a set is
+// full, the entry idle longest is replaced, among equally idle ones the
+// least present, so long present devices are kept. Entries live in a caller provided slab, which may be
+// kept in memory surviving a restart.
+
+#define PRESENCE_WAYS 4
+#define PRESENCE_SEEN 0x01     // seen since last age()
+#define PRESENCE_EXCLUDED 0x02 // present longer than threshold
+
+typedef struct {
+  uint32_t tag;     // device tag, 0 marks a free entry
+  uint16_t present; // [minutes] continuously present
+  uint8_t idle;     // [minutes] since last seen, saturating
+  uint8_t flags;    // PRESENCE_* bits
+} presenceEntry_t;
+
+class PresenceTable {
+public:
+  // slab holds sets * PRESENCE_WAYS entries, sets must be a power of 2
+  PresenceTable(presenceEntry_t *slab, uint32_t sets, uint16_t threshold,
+                uint8_t gap);
+
+  bool seen(uint32_t tag);    // true if device is excluded
+  void age(uint16_t minutes); // call when minutes have passed
+  void clear(void);
+
+  uint32_t size(void) const;     // devices tracked
+  uint32_t excluded(void) const; // devices currently excluded
+  uint32_t capacity(void) const { return nsets * PRESENCE_WAYS; }
+
+private:
+  presenceEntry_t *entry;
+  uint32_t nsets;
+  uint16_t threshold;
+  uint8_t gap;
+};
+
+#endif
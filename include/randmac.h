@@ -0,0 +1,18 @@
+#ifndef _RANDMAC_H
+#define _RANDMAC_H
+
+#include "globals.h"
+#include "devicecache.h"
+#include "macdedup.h"
+
+typedef struct {
+  uint16_t global;    // devices with globally administered MAC
+  uint16_t random;    // devices with randomized (locally administered) MAC
+  uint16_t rotations; // estimated randomized MACs replaced by a new one
+} randStatus_t;
+
+void randmac_add(uint64_t key, bool random, uint32_t now);
+void randmac_clear(void);
+void randmac_count(randStatus_t *status, uint32_t since, uint32_t cycle);
+
+#endif
@@ -4,6 +4,7 @@
 #include <rom/rtc.h>
 
 #include "libpax_helpers.h"
+#include "sniffer.h"
 #include "senddata.h"
 #include "cyclic.h"
 #include "configmanager.h"
@@ -16,10 +17,21 @@
 #include "power.h"
 #include "antenna.h"
 #include "payload.h"
+#include "macaddr.h"
 
 // maximum number of elements in rcommand interpreter queue
 #define RCMD_QUEUE_SIZE 5
 
+// leading opcode which makes the rest of the buffer one transaction
+#define RCMD_TRANSACTION 0x22
+
+// transaction status codes
+#define TXN_OK 0          // all commands committed
+#define TXN_UNKNOWN 1     // unknown opcode
+#define TXN_NOT_ALLOWED 2 // opcode can't be part of a transaction
+#define TXN_MISSING 3     // missing parameter(s)
+#define TXN_INVALID 4     // parameter out of range
+
 extern TaskHandle_t rcmdTask;
 
 // table of remote commands and assigned functions
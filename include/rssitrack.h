@@ -0,0 +1,34 @@
+#ifndef _RSSITRACK_H
+#define _RSSITRACK_H
+
+#include "globals.h"
+#include "devicecache.h"
+#include "macdedup.h"
+
+#define RSSI_BUCKETS 8   // histogram buckets of 10dB, see rssi_bucket()
+#define RSSI_EWMA_SHIFT 3 // ewma weight of a new frame is 1/2^RSSI_EWMA_SHIFT
+#define RSSI_ZONE_NONE 0xFF // device is weaker than all zone thresholds
+
+// maps rssi to bucket 0: < -90dBm, 1: -90..-81dBm, ... , 7: >= -30dBm
+static inline uint8_t rssi_bucket(int16_t rssi) {
+  int16_t b = (rssi + 100) / 10;
+  return (b < 0) ? 0 : ((b >= RSSI_BUCKETS) ? RSSI_BUCKETS - 1 : b);
+}
+
+typedef struct {
+  int16_t ewma; // smoothed rssi [1/16 dBm]
+  bool random;  // device uses a randomized MAC address
+  uint8_t zone; // rssi zone of ewma, see rssi_zones_config()
+  uint32_t counted; // uptime of last frame above the rssi limit, 0 if none
+} rssiValue_t;
+
+void rssi_add(uint64_t key, int8_t rssi, bool random, bool counted,
+              uint32_t now);
+int8_t rssi_mean(uint32_t since);
+void rssi_histogram(uint16_t hist[RSSI_BUCKETS], uint32_t since);
+void rssi_counted(uint32_t since, int16_t nearrssi, uint16_t *near,
+                  uint16_t *random);
+void rssi_zones_config(const int8_t thresholds[RSSI_ZONES]);
+void rssi_zones(uint16_t counts[RSSI_ZONES], uint32_t since);
+
+#endif
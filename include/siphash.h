@@ -0,0 +1,19 @@
+#ifndef _SIPHASH_H
+#define _SIPHASH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// SipHash-2-4 (Aumasson, Bernstein 2012), a keyed 64 bit pseudorandom
+// function. Without the 128 bit key its output can't be linked back to the
+// input, so device tables keyed by it hold no recoverable MAC addresses.
+// No allocation, the MAC variant is unrolled for one 6 byte message.
+
+typedef struct {
+  uint64_t k0, k1;
+} sipKey_t;
+
+uint64_t siphash24(const sipKey_t *key, const uint8_t *data, size_t len);
+uint64_t siphash24_mac(const sipKey_t *key, const uint8_t *paddr);
+
+#endif
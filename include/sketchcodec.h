@@ -0,0 +1,51 @@
+#ifndef _SKETCHCODEC_H
+#define _SKETCHCODEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Wire format of exported HyperLogLog registers, shared by the device and
+// host tools. A sketch is split into packets, each holding a run of
+// registers after a 7 byte header:
+//   byte 0..3  cycle stamp of the sketch, the same in all its packets and in
+//              the sketches of all devices sending the same cycle, msb first
+//   byte 4     precision (bits 0..4), SKETCH_PACKED flag (bit 7)
+//   byte 5..6  index of first register in packet, msb first
+// Registers are one byte each, or packed as 6 bit values, 4 registers in 3
+// bytes, msb first. Since registers merge by maximum, packets of any number
+// of devices can be merged in any order into one union sketch.
+
+#define SKETCH_HEADER_SIZE 7
+#define SKETCH_PACKED 0x80
+#define SKETCH_PRECISION_MASK 0x1F
+
+typedef struct {
+  uint32_t stamp; // cycle stamp, 0 = unknown
+  uint8_t precision;
+  bool packed;
+  uint16_t first; // index of first register
+  uint16_t count; // registers in packet
+} sketchHeader_t;
+
+// registers fitting in a packet of size bytes, a multiple of 4
+uint16_t sketch_chunk(uint16_t size, bool packed);
+
+// stamp of the send cycle of period seconds ending at epoch second now: the
+// start of the period aligned window holding most of the cycle, so devices
+// with the same period and a synced clock stamp their sketches alike
+uint32_t sketch_stamp(uint32_t now, uint32_t period);
+
+// writes header and h->count registers starting at h->first of regs to out,
+// returns bytes written
+uint16_t sketch_encode(uint8_t *out, const sketchHeader_t *h,
+                       const uint8_t *regs);
+
+// reads header of a packet of len bytes, false if malformed
+bool sketch_header(const uint8_t *in, uint16_t len, sketchHeader_t *h);
+
+// merges registers of a packet into regs of 2^precision registers, false
+// if malformed or of other precision
+bool sketch_merge(const uint8_t *in, uint16_t len, uint8_t *regs,
+                  uint8_t precision);
+
+#endif
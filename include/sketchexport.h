@@ -0,0 +1,19 @@
+#ifndef _SKETCHEXPORT_H
+#define _SKETCHEXPORT_H
+
+#include "globals.h"
+#include "hyperloglog.h"
+#include "siphash.h"
+#include "sketchcodec.h"
+
+// Export of a mergeable sketch of the devices of each send cycle. The
+// sketch is keyed by a site key shared by all paxcounters of a site (set by
+// rcommand 0x25) instead of the per device salt of mac_anon(), so sketches
+// of overlapping paxcounters can be merged without double counting, see
+// tools/sketchmerge.cpp.
+
+void export_init(void);
+void export_add(const uint8_t *paddr);
+void export_send(void);
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef _SLIDINGWINDOW_H
+#define _SLIDINGWINDOW_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "hyperloglog.h"
+
+// Ring of small HyperLogLog sketches, one per time slot. Unique counts over
+// any trailing number of slots are estimated by merging the slot sketches,
+// so several horizons are served from one detection stream at fixed memory.
+// Time is passed in by the caller as monotonic seconds.
+
+class SlidingWindow {
+public:
+  // slab must hold (slots + 1) << precision bytes, last part is scratch space
+  SlidingWindow(uint8_t *slab, uint16_t slots, uint8_t precision,
+                uint32_t slotlen);
+
+  void add(uint64_t hash, uint32_t now);
+  // unique in the current slot and the last nslots complete slots, so a
+  // count does not drop at each slot start
+  uint32_t count(uint16_t nslots, uint32_t now);
+  // registers of the slot ago slots before the one of now, zeros if the slot
+  // is not held. Reads only, so callers can merge outside of their lock.
+  void copy(uint16_t ago, uint32_t now, uint8_t *out) const;
+  void clear(void);
+  uint16_t slots(void) const { return nslot; }
+  uint32_t slotlen(void) const { return len; }
+
+private:
+  void advance(uint32_t now);
+  uint8_t *slot(uint16_t i) const { return regs + ((size_t)i << p); }
+
+  uint8_t *regs;
+  uint16_t nslot;
+  uint8_t p;
+  uint32_t len;   // slot length [seconds]
+  uint16_t head;  // slot receiving current detections
+  uint32_t epoch; // now / len of head slot
+};
+
+// convenience wrapper owning its slab
+template <uint16_t SLOTS, uint8_t P> class StaticSlidingWindow
+    : public SlidingWindow {
+  static_assert(P >= HLL_MIN_PRECISION && P <= HLL_MAX_PRECISION,
+                "HLL precision out of range");
+
+public:
+  StaticSlidingWindow(uint32_t slotlen)
+      : SlidingWindow(storage, SLOTS, P, slotlen) {}
+
+private:
+  uint8_t storage[(SLOTS + 1) << P];
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef _SNIFFER_H
+#define _SNIFFER_H
+
+#include <esp_wifi.h>
+#include <esp_gap_ble_api.h>
+
+#include "globals.h"
+#include "ouifilter.h"
+#include "frametype.h"
+#include "spscring.h"
+
+// libpax keeps each detection to itself and only reports totals. To feed our
+// own per device statistics we register callbacks in front of the libpax
+// sniffer handlers and forward frames passing the vendor filter, the
+// stationary filter and the rssi limit to libpax. Apart from these filters
+// the callbacks only push a compact record to a ring, a worker task on the
+// other core anonymizes the MAC, adds it to the export sketch and updates
+// the per device tables.
+//
+// Records carry the raw MAC rather than a hashed id. The export sketch hashes
+// it with the site key shared by all devices of a site, while the device
+// tables use salts of this device only, so no single id serves both, and
+// hashing twice in the callback is what the ring is meant to avoid. The
+// ring is plain RAM, it is never stored or sent, and a MAC stays in it only
+// for the SNIFF_DRAIN_MS until the worker reads and clears its slot, as it
+// does in the frame buffers the driver hands to libpax.
+
+#define DETECT_BLE _bit(0)     // ble, else wifi
+#define DETECT_RANDOM _bit(1)  // randomized MAC
+#define DETECT_COUNTED _bit(2) // passed rssi limit
+
+typedef struct {
+  uint32_t time;       // uptime [seconds]
+  uint8_t mac[6];      // raw, hashed by the worker, see mac_anon()
+  int8_t rssi;
+  uint8_t channel;     // wifi channel, 0 for ble
+  uint8_t frame_class; // see frameClass_t
+  uint8_t flags;       // DETECT_* bits
+} detection_t;
+
+void sniffer_hook_init(void);
+void sniffer_stop(void);
+bool sniffer_detect(const uint8_t *paddr, int8_t rssi, uint8_t channel,
+                    snifftype_t sniff_type, bool random, uint8_t frame_class);
+void sniffer_stats(uint32_t pushed[2], uint32_t dropped[2]);
+
+#endif
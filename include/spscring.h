@@ -0,0 +1,65 @@
+#ifndef _SPSCRING_H
+#define _SPSCRING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+
+// Lock free ring for exactly one producer and one consumer, e.g. a driver
+// callback handing records to a worker task. Each side writes only its own
+// index, acquire/release ordering publishes the records. A full ring drops
+// the new record and counts it, so the producer never waits. Slots are
+// cleared when read, so no record lingers in the ring after it was consumed.
+
+template <typename T, uint32_t N> class SpscRing {
+  static_assert(N && !(N & (N - 1)), "N must be power of 2");
+
+public:
+  SpscRing() : head(0), tail(0), overflow(0), total(0) {}
+
+  // producer side, false if ring was full
+  bool push(const T &item) {
+    const uint32_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= N) {
+      overflow.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    slot[h & (N - 1)] = item;
+    head.store(h + 1, std::memory_order_release);
+    total.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // consumer side, moves up to max records, returns number moved
+  uint32_t pop(T *items, uint32_t max) {
+    const uint32_t t = tail.load(std::memory_order_relaxed);
+    uint32_t n = head.load(std::memory_order_acquire) - t;
+    if (n > max)
+      n = max;
+    for (uint32_t i = 0; i < n; i++) {
+      items[i] = slot[(t + i) & (N - 1)];
+      slot[(t + i) & (N - 1)] = T();
+    }
+    tail.store(t + n, std::memory_order_release);
+    return n;
+  }
+
+  uint32_t size(void) const {
+    return head.load(std::memory_order_acquire) -
+           tail.load(std::memory_order_acquire);
+  }
+  uint32_t capacity(void) const { return N; }
+  uint32_t pushed(void) const { return total.load(std::memory_order_relaxed); }
+  uint32_t dropped(void) const {
+    return overflow.load(std::memory_order_relaxed);
+  }
+
+private:
+  T slot[N];
+  std::atomic<uint32_t> head; // next slot to write, producer only
+  std::atomic<uint32_t> tail; // next slot to read, consumer only
+  std::atomic<uint32_t> overflow;
+  std::atomic<uint32_t> total;
+};
+
+#endif
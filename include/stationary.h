@@ -0,0 +1,22 @@
+#ifndef _STATIONARY_H
+#define _STATIONARY_H
+
+#include "globals.h"
+#include "presence.h"
+#include "siphash.h"
+
+// Exclusion of devices present around the clock, like printers, access
+// points and beacons. The presence table is keyed by a 32 bit tag from its
+// own salt, which unlike the daily salt of mac_anon() lives as long as the
+// table, otherwise each salt rotation would restart the learning. Tags never
+// leave the device, entries of devices which are not stationary age out
+// after STATIONARY_GAP minutes. The table is kept in RTC memory which is not
+// initialized at boot, so it survives warm restarts and deep sleep.
+
+void station_init(void);
+void station_invalidate(void);
+bool station_check(const uint8_t *paddr);
+void station_update(void);
+void station_stats(uint16_t *tracked, uint16_t *excluded, uint32_t *frames);
+
+#endif
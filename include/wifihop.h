@@ -0,0 +1,14 @@
+#ifndef _WIFIHOP_H
+#define _WIFIHOP_H
+
+#include "globals.h"
+#include "chanhop.h"
+#include "macdedup.h"
+
+void hop_start(void);
+void hop_setup(void);
+bool hop_active(void);
+void hop_record(uint64_t key, uint8_t channel);
+uint16_t hop_stats(ChanHopStats stats[CHANHOP_CHANNELS]);
+
+#endif
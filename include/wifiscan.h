@@ -0,0 +1,78 @@
+#ifndef _WIFISCAN_H
+#define _WIFISCAN_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <mutex>
+
+// Non blocking WiFi scan state machine. trigger() starts exactly one scan on
+// the backend and returns at once, poll() collects the results when the
+// backend reports completion and hands them to the completion callback.
+// Results are copied into a caller provided buffer of plain structs, so
+// there is no heap allocation at runtime. The backend is a table of
+// functions, thus the engine runs against the WiFi library on the device
+// and against a mock on the host. trigger(), poll() and reset() may be
+// called from different tasks, the completion callback runs unlocked.
+
+// backend scan status, same values as WiFi.scanComplete()
+#define WIFISCAN_RUNNING -1
+#define WIFISCAN_FAILED -2
+
+// one scan result
+struct DeviceInfo {
+  uint64_t mac; // 48 bit MAC address, packed by mac_to_u64()
+  int8_t rssi;
+  uint8_t channel;
+};
+
+struct WifiScanBackend {
+  bool (*start)(void);     // start async scan, false on error
+  int16_t (*status)(void); // number of results, or WIFISCAN_xxx
+  bool (*result)(int16_t i, DeviceInfo *info); // copy result i
+  void (*release)(void);   // free backend results
+};
+
+// called once per scan with the collected results, count is 0 on failure
+typedef void (*WifiScanCallback)(const DeviceInfo *devices, uint16_t count,
+                                 uint16_t dropped);
+
+class WifiScan {
+public:
+  enum State : uint8_t { IDLE, RUNNING };
+
+  WifiScan(const WifiScanBackend *backend, DeviceInfo *buffer,
+           uint16_t capacity);
+
+  void onComplete(WifiScanCallback cb) { callback = cb; }
+  bool trigger(void); // false if a scan is running or backend failed
+  bool poll(void);    // true if a scan completed during this call
+  void reset(void);   // abandon running scan
+
+  State state(void) const { return st; }
+  uint16_t count(void) const { return n; }
+  uint16_t dropped(void) const { return lost; }
+  const DeviceInfo *results(void) const { return buf; }
+
+private:
+  const WifiScanBackend *be;
+  DeviceInfo *buf;
+  uint16_t cap;
+  uint16_t n;
+  uint16_t lost;
+  std::atomic<State> st; // read unlocked by state()
+  WifiScanCallback callback;
+  std::mutex lock; // guards state and results against concurrent callers
+};
+
+// convenience wrapper owning its result buffer
+template <uint16_t CAPACITY> class StaticWifiScan : public WifiScan {
+public:
+  StaticWifiScan(const WifiScanBackend *backend)
+      : WifiScan(backend, storage, CAPACITY) {}
+
+private:
+  DeviceInfo storage[CAPACITY];
+};
+
+#endif
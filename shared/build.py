@@ -67,6 +67,12 @@ if os.path.isfile(otakeyfile) and os.access(otakeyfile, os.R_OK):
 else:
     sys.exit("Missing file " + otakeyfile + ", please create it! Aborting.")
 
+# generate OUI vendor filter table from csv, if changed
+sys.path.insert(0, shareddir)
+import ouigen
+ouigen.generate(os.path.join (shareddir, "oui.csv"),
+                os.path.join (prjdir, "include", "ouitable.h"))
+
 # parse hal file
 mykeys = {}
 with open(halconfigfile) as myfile:
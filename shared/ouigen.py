@@ -0,0 +1,128 @@
+# ouigen.py
+# generates the perfect hash table of the OUI vendor filter from a csv file
+#
+# standalone: python shared/ouigen.py shared/oui.csv include/ouitable.h
+# called by build.py before each build, regenerates only if csv changed
+#
+# Hash and displace: an OUI selects a bucket, each bucket has a displacement
+# chosen so that all OUIs of all buckets land in distinct table slots. Lookup
+# is two multiplications and one compare, see src/ouifilter.cpp which must
+# use the same hash functions.
+
+import sys
+import os
+import os.path
+
+CLASSES = {"include": 1, "exclude": 2}
+MAX_DISP = 0xFFFF
+
+
+def bucket_hash(oui, bits):
+    return ((oui * 0x85EBCA6B) & 0xFFFFFFFF) >> (32 - bits)
+
+
+def slot_hash(oui, disp, bits):
+    seed = (disp * 0x5BD1E995) & 0xFFFFFFFF
+    return (((oui ^ seed) * 0x9E3779B1) & 0xFFFFFFFF) >> (32 - bits)
+
+
+def pow2_bits(n):
+    bits = 1
+    while (1 << bits) < n:
+        bits += 1
+    return bits
+
+
+def parse(csvfile):
+    entries = {}
+    with open(csvfile) as f:
+        for num, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith("#") or line.startswith("oui,"):
+                continue
+            fields = [x.strip() for x in line.split(",")]
+            if len(fields) < 2 or fields[1] not in CLASSES:
+                sys.exit("%s:%d: expected oui,class[,vendor]" % (csvfile, num))
+            try:
+                oui = int(fields[0].replace(":", "").replace("-", ""), 16)
+            except ValueError:
+                sys.exit("%s:%d: invalid oui %s" % (csvfile, num, fields[0]))
+            if oui > 0xFFFFFF:
+                sys.exit("%s:%d: invalid oui %s" % (csvfile, num, fields[0]))
+            entries[oui] = CLASSES[fields[1]]
+    return entries
+
+
+def build(entries):
+    n = max(len(entries), 1)
+    bbits = pow2_bits((n + 3) // 4)
+    tbits = pow2_bits(n + n // 4)
+
+    while True:
+        buckets = [[] for _ in range(1 << bbits)]
+        for oui in entries:
+            buckets[bucket_hash(oui, bbits)].append(oui)
+
+        table = [0] * (1 << tbits)
+        disp = [0] * (1 << bbits)
+        ok = True
+        # place big buckets first, while the table is still empty
+        for b in sorted(range(len(buckets)), key=lambda b: -len(buckets[b])):
+            if not buckets[b]:
+                break
+            for d in range(MAX_DISP + 1):
+                slots = set(slot_hash(o, d, tbits) for o in buckets[b])
+                if len(slots) == len(buckets[b]) and \
+                        not any(table[s] for s in slots):
+                    break
+            else:
+                ok = False
+                break
+            disp[b] = d
+            for o in buckets[b]:
+                table[slot_hash(o, d, tbits)] = (entries[o] << 24) | o
+        if ok:
+            return bbits, tbits, disp, table
+        tbits += 1
+
+
+def write(headerfile, csvfile, bbits, tbits, disp, table):
+    def rows(values, fmt, per):
+        out = []
+        for i in range(0, len(values), per):
+            out.append("    " + ", ".join(fmt % v for v in values[i:i + per]) + ",")
+        return "\n".join(out)
+
+    with open(headerfile, "w") as f:
+        f.write("// generated by shared/ouigen.py from %s, do not edit\n"
+                % os.path.basename(csvfile))
+        f.write("#ifndef _OUITABLE_H\n#define _OUITABLE_H\n\n")
+        f.write("#include <stdint.h>\n\n")
+        f.write("#define OUI_BUCKET_BITS %d\n" % bbits)
+        f.write("#define OUI_TABLE_BITS %d\n" % tbits)
+        f.write("#define OUI_ENTRIES %d\n\n" % sum(1 for e in table if e))
+        f.write("// displacement per bucket\n")
+        f.write("static const uint16_t oui_disp[%d] = {\n%s\n};\n\n"
+                % (len(disp), rows(disp, "%5d", 8)))
+        f.write("// class << 24 | oui, 0 marks an empty slot\n")
+        f.write("static const uint32_t oui_table[%d] = {\n%s\n};\n\n"
+                % (len(table), rows(table, "0x%08X", 6)))
+        f.write("#endif\n")
+
+
+def generate(csvfile, headerfile, force=False):
+    if not force and os.path.isfile(headerfile) and \
+            os.path.getmtime(headerfile) >= os.path.getmtime(csvfile):
+        return False
+    entries = parse(csvfile)
+    bbits, tbits, disp, table = build(entries)
+    write(headerfile, csvfile, bbits, tbits, disp, table)
+    print("Generated OUI filter table %s: %d OUIs in %d slots"
+          % (headerfile, len(entries), len(table)))
+    return True
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        sys.exit("usage: ouigen.py <csvfile> <headerfile>")
+    generate(sys.argv[1], sys.argv[2], force=True)
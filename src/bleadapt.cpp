@@ -0,0 +1,121 @@
+// Basic Config
+#include "bleadapt.h"
+#include "liveconfig.h"
+#include "configmanager.h"
+
+// BLE scan control. libpax starts the first scan, afterwards our gap hook
+// restarts scans with the live scan time. New scan parameters can't be set
+// while scanning, so for a change we stop the scan, set the parameters on
+// stop completion and start scanning again on parameter set completion.
+// The adaptive duty cycle changes scan window and interval this way.
+static BleDuty bleDuty(BLESCANWINDOW, BLESCANINTERVAL, BLE_MIN_WINDOW,
+                       BLE_MAX_INTERVAL, BLE_DUTY_WIDEN);
+static portMUX_TYPE bleDutyMux = portMUX_INITIALIZER_UNLOCKED;
+static Ticker bleDutyTimer;
+static volatile uint32_t discovered = 0;
+static volatile bool pending = false;  // stop issued, set parameters next
+static volatile bool scanning = false; // scanner is running or starting
+
+static void bleadapt_setparams(void) {
+  // same parameters as libpax uses, but our window and interval
+  esp_ble_scan_params_t params = {
+      .scan_type = BLE_SCAN_TYPE_PASSIVE,
+      .own_addr_type = BLE_ADDR_TYPE_RANDOM,
+      .scan_filter_policy = BLE_SCAN_FILTER_ALLOW_ALL,
+      .scan_interval = (uint16_t)(bleDuty.interval() * 8 / 5), // 0.625ms
+      .scan_window = (uint16_t)(bleDuty.window() * 8 / 5),
+      .scan_duplicate = BLE_SCAN_DUPLICATE_DISABLE};
+  scanning = true;
+  esp_ble_gap_set_scan_params(&params);
+}
+
+static void bleadapt_epoch(void) {
+  portENTER_CRITICAL(&bleDutyMux);
+  const uint32_t newdevs = discovered;
+  discovered = 0;
+  const bool changed = bleDuty.update(newdevs, BLE_DUTY_EPOCH * 1000);
+  portEXIT_CRITICAL(&bleDutyMux);
+
+  if (changed) {
+    ESP_LOGI(TAG, "BLE scan window %ums, interval %ums, %u new devices",
+             bleDuty.window(), bleDuty.interval(), newdevs);
+    bleadapt_restart();
+  }
+}
+
+// call after libpax_counter_start(), libpax starts with full duty
+void bleadapt_start(void) {
+  bleDutyTimer.detach();
+  portENTER_CRITICAL(&bleDutyMux);
+  bleDuty.reset();
+  discovered = 0;
+  portEXIT_CRITICAL(&bleDutyMux);
+  pending = false;
+  scanning = cfg.blescan;
+
+  if (BLE_ADAPTIVE && cfg.blescan)
+    bleDutyTimer.attach(BLE_DUTY_EPOCH, bleadapt_epoch);
+}
+
+// applies current duty and live scan settings, stops scanner if BLE is off
+void bleadapt_restart(void) {
+  if (pending)
+    return; // stop completion will pick up the latest settings
+  if (scanning) {
+    pending = true;
+    esp_ble_gap_stop_scanning();
+  } else if (live.blescan)
+    bleadapt_setparams();
+}
+
+void bleadapt_discovered(void) { discovered++; }
+
+// called by the gap callback hook, true if event must not go to libpax
+bool bleadapt_event(esp_gap_ble_cb_event_t event,
+                    esp_ble_gap_cb_param_t *param) {
+  switch (event) {
+  case ESP_GAP_BLE_SCAN_STOP_COMPLETE_EVT:
+    if (!pending)
+      return false;
+    pending = false;
+    scanning = false;
+    if (live.blescan)
+      bleadapt_setparams();
+    return true;
+
+  case ESP_GAP_BLE_SCAN_PARAM_SET_COMPLETE_EVT:
+    if (live.blescan)
+      esp_ble_gap_start_scanning(live.blescantime);
+    else
+      scanning = false;
+    return true;
+
+  case ESP_GAP_BLE_SCAN_RESULT_EVT:
+    if (param->scan_rst.search_evt != ESP_GAP_SEARCH_INQ_CMPL_EVT)
+      return false;
+    // scan time is over, start next scan
+    scanning = false;
+    if (pending) { // scan ended before our stop, set parameters now
+      pending = false;
+      if (live.blescan)
+        bleadapt_setparams();
+    } else if (live.blescan) {
+      scanning = true;
+      esp_ble_gap_start_scanning(live.blescantime);
+    }
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+// current window and interval [ms], mean duty [per mille] since last call
+void bleadapt_status(uint16_t *window, uint16_t *interval, uint16_t *duty) {
+  portENTER_CRITICAL(&bleDutyMux);
+  *window = bleDuty.window();
+  *interval = bleDuty.interval();
+  *duty = bleDuty.meanDuty();
+  bleDuty.resetMean();
+  portEXIT_CRITICAL(&bleDutyMux);
+}
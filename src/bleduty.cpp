@@ -0,0 +1,73 @@
+#include "bleduty.h"
+
+BleDuty::BleDuty(uint16_t window, uint16_t interval, uint16_t minwindow,
+                 uint16_t maxinterval, uint16_t widen)
+    : ival0(interval ? interval : 1), widen(widen ? widen : 1) {
+  win0 = (window > ival0) ? ival0 : window;
+  winmin = (minwindow > win0) ? win0 : (minwindow ? minwindow : 1);
+  ivalmax = (maxinterval < ival0) ? ival0 : maxinterval;
+
+  // count levels until window and interval both hit their bounds
+  for (lvl = 0; lvl < BLEDUTY_MAX_LEVEL; lvl++) {
+    apply();
+    if ((win == winmin) && (ival == ivalmax))
+      break;
+  }
+  maxlvl = lvl;
+  reset();
+}
+
+// even levels narrow the window, odd levels widen the interval
+void BleDuty::apply(void) {
+  const uint8_t wshift = lvl / 2, ishift = (lvl + 1) / 2;
+  const uint32_t w = win0 >> wshift;
+  const uint32_t i = (uint32_t)ival0 << ishift;
+  win = (w < winmin) ? winmin : w;
+  ival = (i > ivalmax) ? ivalmax : i;
+}
+
+void BleDuty::reset(void) {
+  lvl = 0;
+  apply();
+  resetMean();
+}
+
+bool BleDuty::update(uint32_t newdevs, uint32_t elapsed) {
+  // account duty of the epoch which just ended
+  dutytime += (uint64_t)duty() * elapsed;
+  time += elapsed;
+
+  const uint16_t w = win, i = ival;
+  if (newdevs >= widen)
+    lvl = 0;
+  else if (!newdevs)
+    step(+1);
+  else
+    step(-1);
+  apply();
+  return (w != win) || (i != ival);
+}
+
+// moves one level, skipping levels where a bound leaves duty unchanged
+void BleDuty::step(int8_t dir) {
+  const uint16_t w = win, i = ival;
+  while ((dir > 0) ? (lvl < maxlvl) : (lvl > 0)) {
+    lvl += dir;
+    apply();
+    if ((w != win) || (i != ival))
+      break;
+  }
+}
+
+uint16_t BleDuty::duty(void) const {
+  return (uint16_t)((uint32_t)win * 1000 / ival);
+}
+
+uint16_t BleDuty::meanDuty(void) const {
+  return time ? (uint16_t)(dutytime / time) : duty();
+}
+
+void BleDuty::resetMean(void) {
+  dutytime = 0;
+  time = 0;
+}
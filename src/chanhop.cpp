@@ -0,0 +1,108 @@
+#include <string.h>
+
+#include "chanhop.h"
+
+ChanHop::ChanHop(uint16_t chanmap, uint16_t dwell, uint16_t mindwell,
+                 uint16_t maxdwell, uint8_t explore)
+    : lo(mindwell ? mindwell : 1), hi(maxdwell), explore(explore) {
+  if (hi < lo)
+    hi = lo;
+  if (this->explore > 100)
+    this->explore = 100;
+  setup(chanmap, dwell);
+}
+
+void ChanHop::setup(uint16_t chanmap, uint16_t dwell) {
+  map = chanmap & ((1 << CHANHOP_CHANNELS) - 1);
+  base = (dwell < lo) ? lo : (dwell > hi) ? hi : dwell;
+  cur = 0;
+  rounds = 0;
+  memset(st, 0, sizeof(st));
+  memset(frames, 0, sizeof(frames));
+  memset(newdevs, 0, sizeof(newdevs));
+  memset(listened, 0, sizeof(listened));
+  for (uint8_t c = 0; c < CHANHOP_CHANNELS; c++)
+    st[c].dwell = base;
+}
+
+void ChanHop::record(uint8_t channel, bool isnew) {
+  if (!channel || (channel > CHANHOP_CHANNELS))
+    return;
+  channel--;
+  frames[channel]++;
+  st[channel].frames++;
+  if (isnew) {
+    newdevs[channel]++;
+    st[channel].newdevs++;
+  }
+}
+
+uint8_t ChanHop::next(uint16_t *dwell) {
+  if (!map)
+    return 0;
+
+  // account time spent on the channel we leave
+  if (cur)
+    listened[cur - 1] += st[cur - 1].dwell;
+
+  // find next enabled channel, wrapping around completes a round
+  uint8_t c = cur;
+  do {
+    if (++c > CHANHOP_CHANNELS) {
+      c = 1;
+      if (cur)
+        reweight();
+    }
+  } while (!(map & (1 << (c - 1))));
+
+  cur = c;
+  *dwell = st[c - 1].dwell;
+  return c;
+}
+
+void ChanHop::reweight(void) {
+  uint8_t n = 0;
+  uint64_t sum = 0;
+
+  for (uint8_t c = 0; c < CHANHOP_CHANNELS; c++) {
+    if (!(map & (1 << c)))
+      continue;
+    n++;
+    if (listened[c]) {
+      const uint32_t rate = (uint64_t)(newdevs[c] * CHANHOP_NEW_WEIGHT +
+                                       frames[c]) *
+                            1000 / listened[c];
+      if (rounds)
+        st[c].rate += ((int64_t)rate - st[c].rate) >> CHANHOP_EWMA_SHIFT;
+      else
+        st[c].rate = rate;
+    }
+    sum += st[c].rate;
+    frames[c] = newdevs[c] = listened[c] = 0;
+  }
+  rounds++;
+
+  // round keeps its length, explore share is spread evenly, the rest
+  // follows the activity rates
+  const uint32_t budget = (uint32_t)base * n;
+  const uint32_t floor = budget * explore / 100 / n;
+  const uint32_t rest = budget - floor * n;
+
+  for (uint8_t c = 0; c < CHANHOP_CHANNELS; c++) {
+    if (!(map & (1 << c)))
+      continue;
+    uint32_t d = sum ? floor + (uint32_t)(rest * st[c].rate / sum) : base;
+    st[c].dwell = (d < lo) ? lo : (d > hi) ? hi : d;
+  }
+}
+
+const ChanHopStats *ChanHop::stats(uint8_t channel) const {
+  if (!channel || (channel > CHANHOP_CHANNELS))
+    return NULL;
+  return st + channel - 1;
+}
+
+void ChanHop::resetStats(void) {
+  for (uint8_t c = 0; c < CHANHOP_CHANNELS; c++)
+    st[c].frames = st[c].newdevs = 0;
+}
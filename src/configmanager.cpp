@@ -31,7 +31,8 @@ static void defaultConfig(configData_t *myconfig) {
   myconfig->adrmode = 1;     // 0=disabled, 1=enabled
   myconfig->screensaver = 0; // 0=disabled, 1=enabled
   myconfig->screenon = 1;    // 0=disabled, 1=enabled
-  myconfig->countermode = 0; // 0=cyclic, 1=cumulative, 2=cyclic confirmed
+  myconfig->countermode = 0; // 0=cyclic, 1=cumulative, 2=cyclic confirmed,
+                             // 3=cumulative sketch
   myconfig->rssilimit = 0;   // threshold for rssilimiter
   myconfig->sendcycle = 30;  // payload send cycle [seconds/2]
   myconfig->sleepcycle = 0;  // sleep cycle [seconds/10]
@@ -43,7 +44,22 @@ static void defaultConfig(configData_t *myconfig) {
   myconfig->wifiscan = 1;     // 0=disabled, 1=enabled
   myconfig->wifiant = 0;      // 0=internal, 1=external
   myconfig->rgblum = 30;      // RGB Led luminosity (0..100%)
-  myconfig->payloadmask = 0xFF; // all payloads enabled by default
+  // all payloads but the frame type breakdown enabled by default
+  myconfig->payloadmask = (uint8_t)~FRAMES_DATA;
+
+  // occupancy estimate defaults to wifi + ble devices
+  memset(myconfig->paxcoef, 0, sizeof(myconfig->paxcoef));
+  myconfig->paxcoef[PAX_COEF_WIFI] = 256;
+  myconfig->paxcoef[PAX_COEF_BLE] = 256;
+
+  // rssi zones: near (shelf) >= -55dBm, mid (aisle) >= -70dBm, far >= -85dBm
+  myconfig->rssizone[0] = -55;
+  myconfig->rssizone[1] = -70;
+  myconfig->rssizone[2] = -85;
+  myconfig->rssizone[3] = 0;
+
+  // sketch export site key, all zero until set by rcommand
+  memset(myconfig->sitekey, 0, sizeof(myconfig->sitekey));
 
 #ifdef HAS_BME680
   // initial BSEC state for BME680 sensor
@@ -0,0 +1,46 @@
+#include <math.h>
+
+#include "countfilter.h"
+
+CountFilter::CountFilter(countFilterState_t *state, uint16_t drift,
+                         uint16_t noise)
+    : s(state), q((drift / 100.0f) * (drift / 100.0f)), r(noise / 100.0f) {
+  if (s->magic != COUNTFILTER_MAGIC)
+    reset();
+}
+
+void CountFilter::reset(void) {
+  s->magic = 0;
+  s->last = 0;
+  s->x = 0;
+  s->p = 0;
+}
+
+float CountFilter::update(uint32_t count, uint32_t now, float variance) {
+  // floor of one device, so an empty site still follows new arrivals
+  const float z = count, rz = r * (z > 1 ? z : 1) + variance;
+
+  if (s->magic != COUNTFILTER_MAGIC) { // first measurement
+    s->x = z;
+    s->p = rz;
+    s->last = now;
+    s->magic = COUNTFILTER_MAGIC;
+    return s->x;
+  }
+
+  // predict: variance grows with time passed since last update
+  const float base = s->x > 1 ? s->x : 1;
+  const float minutes = (now > s->last) ? (now - s->last) / 60.0f : 0;
+  s->p += q * base * base * minutes;
+  s->last = now;
+
+  // correct
+  const float k = (s->p + rz > 0) ? s->p / (s->p + rz) : 1;
+  s->x += k * (z - s->x);
+  s->p *= 1 - k;
+  return s->x;
+}
+
+float CountFilter::interval(void) const {
+  return (s->magic == COUNTFILTER_MAGIC) ? COUNTFILTER_Z95 * sqrtf(s->p) : 0;
+}
@@ -105,6 +105,9 @@ void doHousekeeping() {
 #endif
 #endif
 
+  // age stationary devices table
+  station_update();
+
   // check free heap memory
   if (ESP.getMinFreeHeap() <= MEM_LOW) {
     ESP_LOGW(TAG,
@@ -59,8 +59,9 @@ BB_SPI_LCD *dp = NULL;
 #define DISPLAY_PAGE_BME280_680_VALUES  3
 #define DISPLAY_PAGE_TIME_OF_DAY        4
 #define DISPLAY_PAGE_POWER_OVERVIEW     5
-#define DISPLAY_PAGE_PAX_GRAPH          6
-#define DISPLAY_PAGE_BLANK_SCREEN       7
+#define DISPLAY_PAGE_RSSI_ZONES         6
+#define DISPLAY_PAGE_PAX_GRAPH          7
+#define DISPLAY_PAGE_BLANK_SCREEN       8
 
 void dp_setup(int contrast) {
 #if (HAS_DISPLAY) == 1 // I2C OLED
@@ -189,15 +190,16 @@ void dp_refresh(bool nextPage) {
     // page 2: pax + GPS lat/lon
     // page 3: BME280/680 values
     // page 4: timeofday
-    // page 5: pax graph
-    // page 6: power overview
-    // page 7: blank screen
+    // page 5: power overview
+    // page 6: rssi zone counts
+    // page 7: pax graph
+    // page 8: blank screen
 
     // ---------- page 0: parameters overview ----------
   case DISPLAY_PAGE_PAX_PARAM_OVERVIEW:
 
     // show pax
-    libpax_counter_count(&count);
+    get_paxcount(&count);
     dp_setFont(MY_FONT_LARGE);
     dp->printf("%-8u", count.pax);
 
@@ -281,7 +283,7 @@ void dp_refresh(bool nextPage) {
     // 7|SNR:-0000  RSSI:-0000
 
     // show pax
-    libpax_counter_count(&count);
+    get_paxcount(&count);
     dp_setFont(MY_FONT_LARGE);
     dp->printf("%-8u", count.pax);
 
@@ -308,7 +310,7 @@ void dp_refresh(bool nextPage) {
 #if (HAS_GPS)
 
     // show pax
-    libpax_counter_count(&count);
+    get_paxcount(&count);
     dp_setFont(MY_FONT_LARGE);
     dp->printf("%-8u", count.pax);
 
@@ -485,7 +487,24 @@ void dp_refresh(bool nextPage) {
     break;
   }
 
-  // ---------- page 6: pax graph ----------
+  // ---------- page 6: rssi zones ----------
+  case DISPLAY_PAGE_RSSI_ZONES:
+  {
+    uint16_t zones[RSSI_ZONES];
+    rssi_zones(zones, sendcycle_start());
+
+    dp_setFont(MY_FONT_STRETCHED); // 12x16px = 10 chars / line @ 4 lines
+    dp->setCursor(0, 0);
+    for (uint8_t i = 0; i < RSSI_ZONES; i++)
+      if (cfg.rssizone[i])
+        dp->printf("%4ddB%4u\r\n", cfg.rssizone[i], zones[i]);
+      else
+        dp->printf("%-10s\r\n", "");
+    dp_dump();
+    break;
+  }
+
+  // ---------- page 7: pax graph ----------
   case DISPLAY_PAGE_PAX_GRAPH:
 
     // update and show histogram
@@ -493,7 +512,7 @@ void dp_refresh(bool nextPage) {
     dp_dump(plotbuf);
     break;
 
-  // ---------- page 7: blank screen ----------
+  // ---------- page 8: blank screen ----------
   case DISPLAY_PAGE_BLANK_SCREEN:
 
 #ifdef HAS_BUTTON
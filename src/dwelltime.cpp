@@ -0,0 +1,55 @@
+// Basic Config
+#include <algorithm>
+
+#include "dwelltime.h"
+#include "reset.h"
+
+// first and last sighting per device, keyed by the anonymized MAC
+static DeviceCache<uint8_t, DWELL_TABLE_SETS> dwellTable;
+static portMUX_TYPE dwellMux = portMUX_INITIALIZER_UNLOCKED;
+
+void dwell_add(uint64_t key, uint32_t now) {
+
+  portENTER_CRITICAL(&dwellMux);
+  DeviceCache<uint8_t, DWELL_TABLE_SETS>::Entry *e = dwellTable.find(key);
+  // device was away too long, count as new visit
+  if (e && (now - e->last > DWELL_TIMEOUT))
+    e->first = now;
+  dwellTable.lookup(key, now);
+  portEXIT_CRITICAL(&dwellMux);
+}
+
+// called at a salt rotation, devices get new keys and start new visits
+void dwell_clear(void) {
+  portENTER_CRITICAL(&dwellMux);
+  dwellTable.clear();
+  portEXIT_CRITICAL(&dwellMux);
+}
+
+// dwell time percentiles of all devices seen since given uptime [seconds],
+// longer times are clipped to the 16 bit payload field before selection
+void dwell_percentiles(dwellStatus_t *dwell, uint32_t since, uint16_t *times) {
+  uint32_t n = 0;
+
+  portENTER_CRITICAL(&dwellMux);
+  dwellTable.forEach([&](DeviceCache<uint8_t, DWELL_TABLE_SETS>::Entry &e) {
+    if ((e.last >= since) && (n < DWELL_ENTRIES)) {
+      const uint32_t t = e.last - e.first;
+      times[n++] = (t > UINT16_MAX) ? UINT16_MAX : t;
+    }
+  });
+  portEXIT_CRITICAL(&dwellMux);
+
+  dwell->devices = (n > UINT16_MAX) ? UINT16_MAX : n;
+  dwell->p50 = dwell->p90 = 0;
+  if (!n)
+    return;
+
+  uint16_t *p = times + (n - 1) * 50 / 100;
+  std::nth_element(times, p, times + n);
+  dwell->p50 = *p;
+
+  p = times + (n - 1) * 90 / 100;
+  std::nth_element(times, p, times + n);
+  dwell->p90 = *p;
+}
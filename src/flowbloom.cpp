@@ -0,0 +1,60 @@
+#include <string.h>
+
+#include "flowbloom.h"
+
+FlowBloom::FlowBloom(uint32_t *words, uint32_t nbits)
+    : cur(words), prev(words + nbits / 32), mask(nbits - 1),
+      nwords(nbits / 32) {
+  clear();
+}
+
+void FlowBloom::clear(void) {
+  memset(cur, 0, 2 * nwords * sizeof(uint32_t));
+  unique = arrived = previous = 0;
+}
+
+// bit positions by double hashing of both halves of hash
+#define FLOW_BIT(hash, i)                                                      \
+  (((uint32_t)(hash) + (i) * ((uint32_t)((hash) >> 32) | 1)) & mask)
+
+// true if at least one bit was clear, thus device was not yet in set
+bool FlowBloom::insert(uint32_t *set, uint64_t hash) {
+  uint32_t isnew = 0;
+  for (uint8_t i = 0; i < FLOWBLOOM_HASHES; i++) {
+    const uint32_t b = FLOW_BIT(hash, i);
+    isnew |= ~set[b >> 5] & (1U << (b & 31));
+    set[b >> 5] |= 1U << (b & 31);
+  }
+  return isnew != 0;
+}
+
+bool FlowBloom::contains(const uint32_t *set, uint64_t hash) const {
+  for (uint8_t i = 0; i < FLOWBLOOM_HASHES; i++) {
+    const uint32_t b = FLOW_BIT(hash, i);
+    if (!(set[b >> 5] & (1U << (b & 31))))
+      return false;
+  }
+  return true;
+}
+
+void FlowBloom::add(uint64_t hash) {
+  if (!insert(cur, hash))
+    return; // seen before in this interval
+  unique++;
+  if (!contains(prev, hash))
+    arrived++;
+}
+
+void FlowBloom::rotate(uint32_t *arrivals, uint32_t *departures) {
+  // devices seen in both intervals stayed, the rest of previous left
+  const uint32_t stayed = unique - arrived;
+  *arrivals = arrived;
+  *departures = (previous > stayed) ? previous - stayed : 0;
+
+  uint32_t *t = prev;
+  prev = cur;
+  cur = t;
+  memset(cur, 0, nwords * sizeof(uint32_t));
+  previous = unique;
+  unique = arrived = 0;
+}
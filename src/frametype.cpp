@@ -0,0 +1,40 @@
+// Basic Config
+#include "frametype.h"
+
+static uint8_t frameRegs[FRAME_CLASSES][1U << FRAME_HLL_PRECISION];
+static uint32_t frameCount[FRAME_CLASSES];
+static portMUX_TYPE frameMux = portMUX_INITIALIZER_UNLOCKED;
+
+void frame_add(uint64_t key, uint8_t cls) {
+  if (cls >= FRAME_CLASSES)
+    return;
+  portENTER_CRITICAL(&frameMux);
+  frameCount[cls]++;
+  HyperLogLog(frameRegs[cls], FRAME_HLL_PRECISION, true).add(key);
+  portEXIT_CRITICAL(&frameMux);
+}
+
+// frames and unique devices per class since last call
+void frame_stats(frameStats_t *stats) {
+  for (uint8_t c = 0; c < FRAME_CLASSES; c++) {
+    portENTER_CRITICAL(&frameMux);
+    HyperLogLog sketch(frameRegs[c], FRAME_HLL_PRECISION, true);
+    const uint32_t devices = sketch.estimate();
+    const uint32_t frames = frameCount[c];
+    sketch.clear();
+    frameCount[c] = 0;
+    portEXIT_CRITICAL(&frameMux);
+    stats->frames[c] = (frames > UINT16_MAX) ? UINT16_MAX : frames;
+    stats->devices[c] = (devices > UINT16_MAX) ? UINT16_MAX : devices;
+  }
+}
+
+// starts the next breakdown without reading this one
+void frame_reset(void) {
+  portENTER_CRITICAL(&frameMux);
+  for (uint8_t c = 0; c < FRAME_CLASSES; c++) {
+    HyperLogLog(frameRegs[c], FRAME_HLL_PRECISION, true).clear();
+    frameCount[c] = 0;
+  }
+  portEXIT_CRITICAL(&frameMux);
+}
@@ -0,0 +1,110 @@
+#include <string.h>
+
+#include "genbloom.h"
+
+GenBloom::GenBloom(uint8_t *cells, uint32_t ncells, uint8_t generations,
+                   uint32_t window)
+    : cell(cells), m(ncells ? ncells : 1) {
+  if (generations < 1)
+    generations = 1;
+  if (generations > GENBLOOM_MAX_GEN)
+    generations = GENBLOOM_MAX_GEN;
+  ngen = generations;
+  len = 1;
+  setWindow(window);
+  clear();
+}
+
+void GenBloom::clear(void) {
+  memset(cell, 0, m);
+  memset(fresh, 0, sizeof(fresh));
+  epoch = 0;
+  stamp = 1;
+  gen = 0;
+  scrub = 0;
+}
+
+void GenBloom::setWindow(uint32_t window) {
+  const uint32_t l = window / ngen;
+  const uint32_t now = epoch * len;
+  len = l ? l : 1;
+  epoch = now / len;
+}
+
+// start new generations until now, dropping those which left the window
+void GenBloom::advance(uint32_t now) {
+  const uint32_t e = now / len;
+  if (e <= epoch)
+    return;
+
+  uint32_t steps = e - epoch;
+  epoch = e;
+  if (steps > ngen) // whole window expired, cells age out by their stamps
+    steps = ngen;
+
+  while (steps--) {
+    gen = (gen + 1) % ngen;
+    for (uint8_t c = 0; c < GENBLOOM_CLASSES; c++)
+      fresh[c][gen] = 0;
+    tick();
+  }
+}
+
+// next stamp, freeing the expired cells of 1 / GENBLOOM_SCRUB of the filter
+void GenBloom::tick(void) {
+  stamp = stamp % GENBLOOM_STAMPS + 1;
+  for (uint32_t n = (m + GENBLOOM_SCRUB - 1) / GENBLOOM_SCRUB; n; n--) {
+    if (cell[scrub] && (age(cell[scrub]) >= ngen))
+      cell[scrub] = 0;
+    scrub = (scrub + 1) % m;
+  }
+}
+
+bool GenBloom::add(uint64_t hash, uint32_t now, uint8_t cls) {
+  advance(now);
+  if (cls >= GENBLOOM_CLASSES)
+    cls = GENBLOOM_CLASSES - 1;
+
+  // double hashing yields the cell indexes
+  const uint32_t h1 = (uint32_t)hash, h2 = (uint32_t)(hash >> 32) | 1;
+  bool present = true;
+  uint8_t last = 0; // generations since this device was seen
+
+  for (uint32_t i = 0; i < GENBLOOM_HASHES; i++) {
+    uint8_t *c = cell + (h1 + i * h2) % m;
+    if (!*c || (age(*c) >= ngen))
+      present = false;
+    else if (age(*c) > last)
+      last = age(*c);
+    *c = stamp;
+  }
+
+  if (present) {
+    if (!last)
+      return false; // already seen in current generation
+    // move device from generation it was seen last to current one
+    const uint8_t g = (gen + ngen - last) % ngen;
+    if (fresh[cls][g])
+      fresh[cls][g]--;
+  }
+  fresh[cls][gen]++;
+  return !present;
+}
+
+uint32_t GenBloom::count(uint32_t now, uint8_t cls) {
+  advance(now);
+  if (cls >= GENBLOOM_CLASSES)
+    return 0;
+
+  uint32_t sum = 0;
+  for (uint8_t g = 0; g < ngen; g++)
+    sum += fresh[cls][g];
+  return sum;
+}
+
+uint32_t GenBloom::count(uint32_t now) {
+  uint32_t sum = 0;
+  for (uint8_t c = 0; c < GENBLOOM_CLASSES; c++)
+    sum += count(now, c);
+  return sum;
+}
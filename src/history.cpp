@@ -0,0 +1,91 @@
+// Basic Config
+#include "history.h"
+#include "senddata.h"
+#include "timekeeper.h"
+
+#define HISTORY_RECORD_SIZE (3 * HISTORY_SERIES * 2) // bytes in plain payload
+// most records the payload buffer can hold, its size fits in a byte
+#define HISTORY_MAX_RECORDS ((UINT8_MAX - 1) / HISTORY_RECORD_SIZE)
+
+static StaticHourHistory<HISTORY_HOURS> history;
+static portMUX_TYPE historyMux = portMUX_INITIALIZER_UNLOCKED;
+
+// hours follow the clock once it is set, before that the uptime
+static uint32_t history_hour(void) {
+  if (timeSource != _unsynced)
+    return time(NULL) / 3600;
+  return uptime() / 3600000;
+}
+
+// called once per send cycle with the count of the cycle
+void history_add(const struct count_payload_t *count) {
+  const uint32_t c[HISTORY_SERIES] = {count->pax, count->wifi_count,
+                                      count->ble_count};
+  uint16_t v[HISTORY_SERIES];
+  for (uint8_t s = 0; s < HISTORY_SERIES; s++)
+    v[s] = (c[s] > UINT16_MAX) ? UINT16_MAX : c[s];
+  const uint32_t hour = history_hour();
+  portENTER_CRITICAL(&historyMux);
+  history.add(hour, v);
+  portEXIT_CRITICAL(&historyMux);
+}
+
+// records which fit in one uplink at current datarate
+static uint8_t history_perpacket(void) {
+#if (PAYLOAD_ENCODER >= 3)
+  return 1; // cayenne channels can't repeat in a packet
+#else
+  uint16_t maxpayload = UINT16_MAX;
+#if (HAS_LORA)
+  maxpayload = lora_maxpayload();
+#endif
+  return history_records(payload.getCapacity(), maxpayload,
+                         HISTORY_RECORD_SIZE);
+#endif
+}
+
+// sends the given number of hours back from the hour first hours ago,
+// oldest first, in at most HISTORY_MAX_UPLINKS packets on HISTORYPORT.
+// Each packet starts with the age [hours] of its first record, the next
+// records are one hour younger each. hours = 0 sends all hours held.
+void history_send(uint8_t first, uint8_t hours) {
+  histRecord_t rec[HISTORY_MAX_RECORDS];
+  const uint8_t perpacket = history_perpacket();
+  if (!perpacket) {
+    ESP_LOGW(TAG, "History record does not fit in payload buffer");
+    return;
+  }
+
+  portENTER_CRITICAL(&historyMux);
+  const uint16_t held = history.held();
+  portEXIT_CRITICAL(&historyMux);
+  if (first >= held) {
+    ESP_LOGI(TAG, "History holds %u hours, nothing to send", held);
+    return;
+  }
+  if (!hours || (first + hours > held))
+    hours = held - first;
+
+  int32_t ago = first + hours - 1;
+  uint8_t packets = 0;
+  while ((ago >= first) && (packets < HISTORY_MAX_UPLINKS)) {
+    const uint8_t start = ago;
+    uint8_t n = 0;
+    portENTER_CRITICAL(&historyMux);
+    while ((n < perpacket) && (ago >= first) && history.get(ago, rec + n)) {
+      n++;
+      ago--;
+    }
+    portEXIT_CRITICAL(&historyMux);
+    if (!n)
+      break;
+    payload.reset();
+    payload.addHistory(start, rec, n);
+    SendPayload(HISTORYPORT);
+    packets++;
+  }
+
+  if (ago >= first)
+    ESP_LOGW(TAG, "History: newest %d hours not sent, query them again",
+             ago - first + 1);
+}
@@ -0,0 +1,74 @@
+#include <string.h>
+
+#include "hourhistory.h"
+
+static void empty_record(histRecord_t *r) {
+  for (uint8_t s = 0; s < HISTORY_SERIES; s++) {
+    r->min[s] = UINT16_MAX;
+    r->max[s] = 0;
+    r->mean[s] = 0;
+  }
+}
+
+HourHistory::HourHistory(histRecord_t *slab, uint16_t hours)
+    : rec(slab), n(hours ? hours : 1) {
+  clear();
+}
+
+void HourHistory::clear(void) {
+  head = count = 0;
+  hour = 0;
+  samples = 0;
+  memset(sum, 0, sizeof(sum));
+}
+
+// closes current hour and starts the given number of new ones
+void HourHistory::advance(uint16_t hours) {
+  while (hours--) {
+    head = (head + 1) % n;
+    if (count < n)
+      count++;
+    empty_record(rec + head);
+  }
+  samples = 0;
+  memset(sum, 0, sizeof(sum));
+}
+
+void HourHistory::add(uint32_t h, const uint16_t value[HISTORY_SERIES]) {
+  if (!count) {
+    count = 1;
+    empty_record(rec + head);
+    hour = h;
+  } else if (h != hour) {
+    const uint32_t gap = h - hour;
+    advance((h > hour) && (gap < n) ? gap : 1);
+    hour = h;
+  }
+
+  histRecord_t *r = rec + head;
+  samples++;
+  for (uint8_t s = 0; s < HISTORY_SERIES; s++) {
+    if (value[s] < r->min[s])
+      r->min[s] = value[s];
+    if (value[s] > r->max[s])
+      r->max[s] = value[s];
+    sum[s] += value[s];
+    r->mean[s] = (sum[s] + samples / 2) / samples;
+  }
+}
+
+bool HourHistory::get(uint16_t ago, histRecord_t *r) const {
+  if (ago >= count)
+    return false;
+  *r = rec[(head + n - ago) % n];
+  return true;
+}
+
+uint8_t history_records(uint8_t capacity, uint16_t maxpayload,
+                        uint8_t recsize) {
+  if (!recsize || capacity < 1 + recsize)
+    return 0;
+  const uint16_t size = (maxpayload < capacity) ? maxpayload : capacity;
+  const uint8_t n = (size > recsize) ? (size - 1) / recsize : 0;
+  return n ? n : 1;
+}
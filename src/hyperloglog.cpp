@@ -0,0 +1,75 @@
+#include <math.h>
+
+#include "hyperloglog.h"
+
+HyperLogLog::HyperLogLog(uint8_t *registers, uint8_t precision, bool attach)
+    : regs(registers) {
+  if (precision < HLL_MIN_PRECISION)
+    precision = HLL_MIN_PRECISION;
+  if (precision > HLL_MAX_PRECISION)
+    precision = HLL_MAX_PRECISION;
+  p = precision;
+  m = 1UL << p;
+  if (!attach)
+    clear();
+}
+
+void HyperLogLog::clear(void) {
+  for (uint32_t i = 0; i < m; i++)
+    regs[i] = 0;
+}
+
+void HyperLogLog::add(uint64_t hash) {
+  // first p bits select the register, the rest yields the rank
+  const uint32_t idx = (uint32_t)(hash >> (64 - p));
+  const uint64_t w = hash << p;
+  const uint8_t rank = w ? (uint8_t)(__builtin_clzll(w) + 1) : (64 - p + 1);
+
+  if (rank > regs[idx])
+    regs[idx] = rank;
+}
+
+bool HyperLogLog::merge(const HyperLogLog &other) {
+  if (other.p != p)
+    return false;
+  for (uint32_t i = 0; i < m; i++)
+    if (other.regs[i] > regs[i])
+      regs[i] = other.regs[i];
+  return true;
+}
+
+uint32_t HyperLogLog::estimate(void) const {
+  float sum = 0;
+  uint32_t zeros = 0;
+
+  for (uint32_t i = 0; i < m; i++) {
+    sum += ldexpf(1.0f, -regs[i]);
+    if (!regs[i])
+      zeros++;
+  }
+
+  float alpha;
+  switch (m) {
+  case 16:
+    alpha = 0.673f;
+    break;
+  case 32:
+    alpha = 0.697f;
+    break;
+  case 64:
+    alpha = 0.709f;
+    break;
+  default:
+    alpha = 0.7213f / (1.0f + 1.079f / m);
+  }
+
+  float e = alpha * m * m / sum;
+
+  // small range correction: linear counting while registers are empty
+  if (e <= 2.5f * m && zeros)
+    e = m * logf((float)m / zeros);
+
+  return (uint32_t)(e + 0.5f);
+}
+
+float HyperLogLog::stderror(void) const { return 1.04f / sqrtf((float)m); }
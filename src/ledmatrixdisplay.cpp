@@ -10,6 +10,7 @@
 uint8_t MatrixDisplayIsOn = 0;
 static uint8_t displaybuf[LED_MATRIX_WIDTH * LED_MATRIX_HEIGHT / 8] = {0};
 static unsigned long ulLastNumMacs = 0;
+static uint32_t ulLastCycle = 0;
 static time_t ulLastTime = time(NULL);
 static struct count_payload_t count; // libpax count storage
 
@@ -74,9 +75,9 @@ void refreshTheMatrixDisplay(bool nextPage) {
   case 0:
 
     // update counter values from libpax
-    libpax_counter_count(&count);
+    get_paxcount(&count);
 
-    if (cfg.countermode == 1) {
+    if ((cfg.countermode == 1) || (cfg.countermode == 3)) {
       // cumulative counter mode -> display total number of pax
       if (ulLastNumMacs != count.pax) {
         ulLastNumMacs = count.pax;
@@ -86,9 +87,12 @@ void refreshTheMatrixDisplay(bool nextPage) {
     }
 
     else { // cyclic counter mode -> plot a line diagram
-      if (ulLastNumMacs != count.pax) {
+      // count is a sliding window, so step one column per send cycle
+      const uint32_t cycle = uptime() / 1000 / (cfg.sendcycle * 2);
+      if ((ulLastNumMacs != count.pax) || (ulLastCycle != cycle)) {
         // next count cycle?
-        if (count.pax == 0) {
+        if (ulLastCycle != cycle) {
+          ulLastCycle = cycle;
           // matrix full? then scroll left 1 dot, else increment column
           if (col < (LED_MATRIX_WIDTH - 1))
             col++;
@@ -1,17 +1,251 @@
+#include <rom/crc.h>
+
 #include "libpax_helpers.h"
+#include "sniffer.h"
 
 
 // libpax payload
 struct count_payload_t count_from_libpax;
 
-int8_t getRSSI() {
-    // Placeholder implementation to retrieve RSSI value
-    // This should be replaced with actual logic to get RSSI from Wi-Fi or BLE
-    return -60; // Example value
+// fixed size sketches for cumulative counting in countermode 3. Registers
+// live in RTC memory, so the count continues after deep sleep without a copy.
+// A checksum taken before sleep validates them after wakeup. Sketches too
+// large for RTC memory are kept in RAM and restart empty after sleep.
+#if (HLL_PRECISION <= SKETCH_RTC_PRECISION)
+#define SKETCH_ATTR RTC_DATA_ATTR
+#else
+#define SKETCH_ATTR
+#endif
+#define SKETCH_MAGIC 0x534b4831
+
+typedef struct {
+  uint32_t magic; // SKETCH_MAGIC if registers were sealed before sleep
+  uint8_t precision;
+  uint32_t crc; // over registers of both sketches
+} sketchSeal_t;
+
+SKETCH_ATTR static uint8_t sketchRegs[2][1U << HLL_PRECISION];
+RTC_DATA_ATTR static sketchSeal_t sketchSeal;
+static HyperLogLog sketch_wifi(sketchRegs[0], HLL_PRECISION, true),
+    sketch_ble(sketchRegs[1], HLL_PRECISION, true);
+
+// ring of per slot sketches for trailing window counts
+static StaticSlidingWindow<WINDOW_SLOTS, WINDOW_PRECISION>
+    window(WINDOW_SLOTLEN);
+static portMUX_TYPE windowMux = portMUX_INITIALIZER_UNLOCKED;
+static const uint16_t window_horizon[WINDOW_HORIZONS] = {1, 5, 15, 60};
+static_assert(WINDOW_SLOTS >= 60 + 1,
+              "WINDOW_SLOTS must hold the longest horizon and current slot");
+static_assert(WINDOW_PRECISION <= 8, "window_count() merges on the stack");
+
+// devices seen during the last send cycle, for display in cyclic modes
+static StaticGenBloom<BLOOM_CELLS> recent(BLOOM_GENERATIONS, SENDCYCLE * 2);
+static portMUX_TYPE recentMux = portMUX_INITIALIZER_UNLOCKED;
+
+#if (FLOW_COUNT)
+// devices of this and the last send cycle, for arrivals and departures
+static StaticFlowBloom<FLOW_BITS> flow;
+static portMUX_TYPE flowMux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+// smoothed count, state survives deep sleep
+RTC_DATA_ATTR static countFilterState_t smoothState;
+static CountFilter smoother(&smoothState, SMOOTH_DRIFT, SMOOTH_NOISE);
+
+// mean rssi of devices seen during the last send cycle
+int8_t getRSSI() { return rssi_mean(sendcycle_start()); }
+
+// uptime [seconds] one send cycle ago
+uint32_t sendcycle_start(void) {
+  const uint32_t now = uptime() / 1000, cycle = cfg.sendcycle * 2;
+  return (now > cycle) ? now - cycle : 0;
+}
+
+void sketch_add(uint64_t hash, snifftype_t sniff_type) {
+  if (sniff_type == MAC_SNIFF_WIFI)
+    sketch_wifi.add(hash);
+  else
+    sketch_ble.add(hash);
+}
+
+// called before deep sleep, after sniffing stopped
+void sketch_save(void) {
+#if (HLL_PRECISION <= SKETCH_RTC_PRECISION)
+  sketchSeal.precision = HLL_PRECISION;
+  sketchSeal.crc =
+      crc32_le(0, (const uint8_t *)sketchRegs, sizeof(sketchRegs));
+  sketchSeal.magic = SKETCH_MAGIC;
+#endif
+}
+
+// true if the sketches hold a valid count from before deep sleep. The seal
+// is broken at once, so a stale count is never restored twice.
+static bool sketch_restore(void) {
+  const bool valid =
+      (RTC_runmode == RUNMODE_WAKEUP) && (sketchSeal.magic == SKETCH_MAGIC) &&
+      (sketchSeal.precision == HLL_PRECISION) &&
+      (sketchSeal.crc ==
+       crc32_le(0, (const uint8_t *)sketchRegs, sizeof(sketchRegs)));
+  if ((sketchSeal.magic == SKETCH_MAGIC) && !valid)
+    ESP_LOGW(TAG, "Sketch in RTC memory corrupted, count restarts");
+  sketchSeal.magic = 0;
+  return valid;
+}
+
+void sketch_clear(void) {
+  sketch_wifi.clear();
+  sketch_ble.clear();
+}
+
+// cumulative count continues after deep sleep, otherwise starts empty. Later
+// restarts of libpax, e.g. for a new send cycle, keep counting.
+static void sketch_init(void) {
+  static bool started = false;
+  if (started)
+    return;
+  started = true;
+  if (sketch_restore())
+    ESP_LOGI(TAG, "Sketch count restored after sleep: wifi=%u / ble=%u",
+             sketch_wifi.estimate(), sketch_ble.estimate());
+  else
+    sketch_clear();
+}
+
+// fills count with sketch estimates, error is the absolute standard error
+void sketch_count(struct count_payload_t *count, uint16_t *error) {
+  count->wifi_count = sketch_wifi.estimate();
+  count->ble_count = sketch_ble.estimate();
+  count->pax = count->wifi_count + count->ble_count;
+
+  if (error) {
+    // errors of both sketches are independent, so they add as variances
+    const float ew = count->wifi_count * sketch_wifi.stderror();
+    const float eb = count->ble_count * sketch_ble.stderror();
+    const float e = sqrtf(ew * ew + eb * eb) + 0.5f;
+    *error = (e > UINT16_MAX) ? UINT16_MAX : (uint16_t)e;
+  }
+}
+
+// wifi and ble sniffer callbacks run in different tasks, so lock the ring
+void window_add(uint64_t hash, uint32_t now) {
+  portENTER_CRITICAL(&windowMux);
+  window.add(hash, now);
+  portEXIT_CRITICAL(&windowMux);
+}
+
+// unique devices seen in the current slot and the last 1/5/15/60 complete
+// slots. Horizons are nested, so one pass merges each slot once. Slots are
+// copied one at a time under the lock, merges and estimates run outside.
+void window_count(uint16_t counts[WINDOW_HORIZONS]) {
+  const uint32_t now = uptime() / 1000;
+  uint8_t slot[1U << WINDOW_PRECISION], sum[1U << WINDOW_PRECISION];
+  HyperLogLog total(sum, WINDOW_PRECISION);
+  uint8_t i = 0;
+  for (uint16_t ago = 0; i < WINDOW_HORIZONS; ago++) {
+    portENTER_CRITICAL(&windowMux);
+    window.copy(ago, now, slot);
+    portEXIT_CRITICAL(&windowMux);
+    total.merge(HyperLogLog(slot, WINDOW_PRECISION, true));
+    for (; (i < WINDOW_HORIZONS) && (window_horizon[i] == ago); i++) {
+      const uint32_t c = total.estimate();
+      counts[i] = (c > UINT16_MAX) ? UINT16_MAX : (uint16_t)c;
+    }
+  }
+}
+
+// true if device was not seen during the last send cycle
+bool recent_add(uint64_t hash, snifftype_t sniff_type, uint32_t now) {
+  portENTER_CRITICAL(&recentMux);
+  const bool isnew =
+      recent.add(hash, now, (sniff_type == MAC_SNIFF_WIFI) ? 0 : 1);
+  portEXIT_CRITICAL(&recentMux);
+  return isnew;
+}
+
+// devices seen in the last send cycle, moves smoothly over cycle boundaries
+void recent_count(struct count_payload_t *count) {
+  const uint32_t now = uptime() / 1000;
+  portENTER_CRITICAL(&recentMux);
+  count->wifi_count = recent.count(now, 0);
+  count->ble_count = recent.count(now, 1);
+  portEXIT_CRITICAL(&recentMux);
+  count->pax = count->wifi_count + count->ble_count;
+}
+
+#if (FLOW_COUNT)
+
+void flow_add(uint64_t hash) {
+  portENTER_CRITICAL(&flowMux);
+  flow.add(hash);
+  portEXIT_CRITICAL(&flowMux);
+}
+
+// called once per send cycle, devices which arrived and departed since the
+// previous call
+void flow_cycle(uint16_t *arrivals, uint16_t *departures) {
+  uint32_t a, d;
+  portENTER_CRITICAL(&flowMux);
+  flow.rotate(&a, &d);
+  portEXIT_CRITICAL(&flowMux);
+  *arrivals = (a > UINT16_MAX) ? UINT16_MAX : a;
+  *departures = (d > UINT16_MAX) ? UINT16_MAX : d;
+  ESP_LOGD(TAG, "Arrivals %u / departures %u", *arrivals, *departures);
+}
+
+#else
+
+void flow_add(uint64_t hash) {}
+void flow_cycle(uint16_t *arrivals, uint16_t *departures) {
+  *arrivals = *departures = 0;
+}
+
+#endif
+
+// feeds the count of a send cycle to the smoothing filter, returns smoothed
+// count and half width of its 95% confidence interval. error is the standard
+// error of a sketch count, it adds to the measurement noise.
+void count_smooth(const struct count_payload_t *count, uint16_t error,
+                  uint16_t *value, uint8_t *ci) {
+  const float x = smoother.update(count->pax, uptime() / 1000,
+                                  (float)error * error);
+  const float e = smoother.interval();
+  *value = (x > UINT16_MAX) ? UINT16_MAX : (uint16_t)(x + 0.5f);
+  *ci = (e > UINT8_MAX) ? UINT8_MAX : (uint8_t)(e + 0.5f);
+  ESP_LOGD(TAG, "Smoothed count %u +/- %u", *value, *ci);
+}
+
+// current count according to counter mode, use instead of
+// libpax_counter_count()
+void get_paxcount(struct count_payload_t *count) {
+  switch (cfg.countermode) {
+  case 1: // cumulative
+    libpax_counter_count(count);
+    break;
+  case 3: // cumulative sketch
+    sketch_count(count, NULL);
+    break;
+  default: // cyclic
+    recent_count(count);
+  }
 }
 
 void init_libpax(void) {
+  sketch_init();
+  // window follows send cycle, but is not cleared to avoid a count drop
+  portENTER_CRITICAL(&recentMux);
+  recent.setWindow(cfg.sendcycle * 2);
+  portEXIT_CRITICAL(&recentMux);
+  // settings we change live are taken over from libpax
+  live_init();
+  libpax_config_t current_config;
+  libpax_get_current_config(&current_config);
+  if (live_config(&current_config))
+    libpax_update_config(&current_config);
+  // in sketch mode libpax runs cyclic, so its MAC list can't grow unbounded
   libpax_counter_init(setSendIRQ, &count_from_libpax, cfg.sendcycle * 2,
-                      cfg.countermode);
+                      (cfg.countermode == 3) ? 0 : cfg.countermode);
   libpax_counter_start();
-}
\ No newline at end of file
+  sniffer_hook_init();
+  hop_start();
+  bleadapt_start();
+}
@@ -0,0 +1,169 @@
+// Basic Config
+#include "liveconfig.h"
+#include "libpax_helpers.h"
+
+#include <esp_wifi.h>
+
+sniffcfg_t live;
+
+static portMUX_TYPE liveMux = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool pending = false;
+static volatile uint8_t batch = 0; // nesting depth of open batches
+static volatile bool dirty = false; // changes committed in open batch
+static volatile bool restart = false; // libpax restart requested
+static bool applying = false; // live_apply() running, guarded by liveMux
+
+static void live_schedule(void);
+
+// state of libpax as of last init_libpax()
+static uint8_t started_wifi, started_ble, started_cycle;
+
+// settings libpax can only change by a restart are taken over by us: rssi
+// limit is applied in the sniffer hook before frames go to libpax, channel
+// hopping runs on our timer, BLE scans are restarted by our gap hook.
+// Other settings are synced from cfg. Returns true if config was changed.
+bool live_config(struct libpax_config_t *config) {
+  const struct libpax_config_t before = *config;
+  config->wificounter = cfg.wifiscan;
+  config->blecounter = cfg.blescan;
+  config->wifi_channel_map = cfg.wifichanmap;
+  config->blescantime = cfg.blescantime;
+  config->wifi_channel_switch_interval = 0;
+  config->wifi_rssi_threshold = 0;
+  config->ble_rssi_threshold = 0;
+  return memcmp(&before, config, sizeof(before)) != 0;
+}
+
+static void live_copy(void) {
+  // rssi is int8, so limits beyond its range count all or no devices
+  live.rssilimit = (cfg.rssilimit < INT8_MIN)   ? INT8_MIN
+                   : (cfg.rssilimit > INT8_MAX) ? INT8_MAX
+                                                : cfg.rssilimit;
+  live.wifiscan = cfg.wifiscan;
+  live.blescan = cfg.blescan;
+  live.wifichanmap = cfg.wifichanmap;
+  live.wifichancycle = cfg.wifichancycle;
+  live.blescantime = cfg.blescantime;
+  live.sendcycle = cfg.sendcycle;
+  memcpy(live.rssizone, cfg.rssizone, sizeof(live.rssizone));
+}
+
+// call before the sniffers start
+void live_init(void) {
+  portENTER_CRITICAL(&liveMux);
+  live_copy();
+  pending = false;
+  portEXIT_CRITICAL(&liveMux);
+  rssi_zones_config(live.rssizone);
+  started_wifi = cfg.wifiscan;
+  started_ble = cfg.blescan;
+  started_cycle = cfg.sendcycle;
+}
+
+// changes committed between live_begin() and live_end() take effect together
+void live_begin(void) { batch++; }
+
+void live_end(void) {
+  if (batch && --batch)
+    return; // outer batch still open
+  if (dirty || restart)
+    live_schedule();
+}
+
+// call after changing sniffer settings in cfg
+void live_commit(void) {
+  dirty = true;
+  if (!batch)
+    live_schedule();
+}
+
+// call for changes which need a libpax restart, like the counter mode
+void live_restart(void) {
+  restart = true;
+  if (!batch)
+    live_schedule();
+}
+
+static void live_schedule(void) {
+  dirty = false;
+
+  // a sniffer libpax did not start can't be switched on live
+  if (restart || (cfg.wifiscan && !started_wifi) ||
+      (cfg.blescan && !started_ble)) {
+    ESP_LOGI(TAG, "Restarting libpax for new configuration");
+    libpax_counter_stop();
+    if (restart)
+      sketch_clear(); // new counter mode starts a new count
+    restart = false;
+    init_libpax();
+    return;
+  }
+
+  portENTER_CRITICAL(&liveMux);
+  pending = true;
+  portEXIT_CRITICAL(&liveMux);
+  // without a running hop timer there is no boundary to wait for
+  if (!hop_active())
+    live_apply();
+}
+
+bool live_pending(void) { return pending && !batch; }
+
+// reconfigures all parts whose live settings differ from old
+static void live_changed(const sniffcfg_t *old) {
+  if (live.rssilimit != old->rssilimit)
+    ESP_LOGI(TAG, "RSSI limit now %d", live.rssilimit);
+
+  if (memcmp(live.rssizone, old->rssizone, sizeof(live.rssizone))) {
+    rssi_zones_config(live.rssizone);
+    ESP_LOGI(TAG, "RSSI zones now %d/%d/%d/%d dBm", live.rssizone[0],
+             live.rssizone[1], live.rssizone[2], live.rssizone[3]);
+  }
+
+  if ((live.wifiscan != old->wifiscan) ||
+      (live.wifichanmap != old->wifichanmap) ||
+      (live.wifichancycle != old->wifichancycle)) {
+    if (live.wifiscan != old->wifiscan)
+      esp_wifi_set_promiscuous(live.wifiscan);
+    hop_setup();
+  }
+
+  if ((live.blescan != old->blescan) || (live.blescantime != old->blescantime))
+    bleadapt_restart();
+
+  if (live.sendcycle != old->sendcycle)
+    ESP_LOGI(TAG, "Send cycle %u seconds from next cycle on",
+             live.sendcycle * 2);
+}
+
+// called at the hop boundary by the hop timer, or by the rcmd task if no
+// hop timer runs. Only one caller applies at a time, it also takes over
+// changes committed while it applies.
+void live_apply(void) {
+  portENTER_CRITICAL(&liveMux);
+  if (!pending || batch || applying) {
+    portEXIT_CRITICAL(&liveMux);
+    return;
+  }
+  applying = true;
+  do {
+    const sniffcfg_t old = live;
+    live_copy();
+    pending = false;
+    portEXIT_CRITICAL(&liveMux);
+    live_changed(&old);
+    portENTER_CRITICAL(&liveMux);
+  } while (pending && !batch);
+  applying = false;
+  portEXIT_CRITICAL(&liveMux);
+}
+
+// called after a send cycle completed, a new send cycle length needs a
+// restart of libpax, which is cheap right after the counts were sent. The
+// cumulative sketch count continues, see init_libpax().
+void live_sendcycle(void) {
+  if (live.sendcycle == started_cycle)
+    return;
+  libpax_counter_stop();
+  init_libpax();
+}
@@ -206,7 +206,7 @@ void lora_send(void *pvParameters) {
     // attempt to transmit payload
     switch (LMIC_setTxData2_strict(SendBuffer.MessagePort, SendBuffer.Message,
                                    SendBuffer.MessageSize,
-                                   (cfg.countermode & 0x02))) {
+                                   (cfg.countermode == 2))) {
     case LMIC_ERROR_SUCCESS:
 #if (TIME_SYNC_LORASERVER)
       // if last packet sent was a timesync request, store TX timestamp
@@ -455,6 +455,17 @@ const char *getCrName(rps_t rps) {
   return t[getCr(rps)];
 }
 
+// maximum application payload [bytes] at current uplink datarate, see
+// LoRaWAN regional parameters (no repeater)
+uint8_t lora_maxpayload(void) {
+#if defined(CFG_us915)
+  static const uint8_t t[] = {11, 53, 125, 242, 242};
+#else
+  static const uint8_t t[] = {51, 51, 51, 115, 242, 242, 242, 242};
+#endif
+  return (LMIC.datarate < sizeof(t)) ? t[LMIC.datarate] : t[0];
+}
+
 /*******************************************************************************
  *
  * ttn-esp32 - The Things Network device library for ESP-IDF / SX127x
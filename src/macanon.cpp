@@ -0,0 +1,58 @@
+// Basic Config
+#include "macanon.h"
+#include "reset.h"
+
+#define ANON_MAGIC 0x414e4f32
+
+// two salt slots, the sniffer tasks read the active one while a rotation
+// writes the other one, then flips the index
+typedef struct {
+  uint32_t magic; // ANON_MAGIC if salt is valid
+  uint32_t born;  // uptime [seconds] of current salt
+  sipKey_t key[2];
+  volatile uint8_t active;
+  sipKey_t fixed; // never rotates, see mac_anon_fixed()
+} anonSalt_t;
+
+RTC_DATA_ATTR static anonSalt_t anonSalt;
+
+static void anon_rotate(uint32_t now) {
+  sipKey_t *k = anonSalt.key + (anonSalt.active ^ 1);
+  k->k0 = ((uint64_t)esp_random() << 32) | esp_random();
+  k->k1 = ((uint64_t)esp_random() << 32) | esp_random();
+  anonSalt.born = now;
+  anonSalt.active ^= 1;
+}
+
+// at boot, salt of before deep sleep is kept so tables restored from RTC
+// memory stay valid
+void anon_init(void) {
+  const uint32_t now = uptime() / 1000;
+  if ((RTC_runmode == RUNMODE_WAKEUP) && (anonSalt.magic == ANON_MAGIC)) {
+    anon_update();
+    return;
+  }
+  anonSalt.active = 0;
+  anon_rotate(now);
+  anonSalt.fixed.k0 = ((uint64_t)esp_random() << 32) | esp_random();
+  anonSalt.fixed.k1 = ((uint64_t)esp_random() << 32) | esp_random();
+  anonSalt.magic = ANON_MAGIC;
+}
+
+// call periodically, devices seen after a rotation get new keys
+bool anon_update(void) {
+  const uint32_t now = uptime() / 1000;
+  if (now - anonSalt.born < ANON_SALT_ROTATE)
+    return false;
+  anon_rotate(now);
+  ESP_LOGI(TAG, "MAC anonymization salt rotated");
+  return true;
+}
+
+uint64_t mac_anon(const uint8_t *paddr) {
+  return siphash24_mac(anonSalt.key + anonSalt.active, paddr);
+}
+
+uint64_t mac_anon_fixed(const uint8_t *paddr) {
+  return siphash24_mac(&anonSalt.fixed, paddr);
+}
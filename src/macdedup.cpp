@@ -0,0 +1,53 @@
+#include "macdedup.h"
+
+// slots hold the key with bit 63 set, an all zero slot is free
+#define MACDEDUP_USED (1ULL << 63)
+
+MacDedup::MacDedup(uint64_t *slab, uint32_t slots) : keys(slab) {
+  // round number of slots down to a power of two
+  uint32_t n = 1;
+  while (slots && (n << 1) <= slots)
+    n <<= 1;
+  mask = n - 1;
+  limit = (uint32_t)(((uint64_t)n * MACDEDUP_MAX_LOAD) / 100);
+  clear();
+}
+
+void MacDedup::clear(void) {
+  for (uint32_t i = 0; i <= mask; i++)
+    keys[i] = 0;
+  count = 0;
+  overflow = 0;
+}
+
+bool MacDedup::insert(uint64_t mac) {
+  const uint64_t key = (mac & 0xFFFFFFFFFFFFULL) | MACDEDUP_USED;
+  uint32_t i = (uint32_t)mac_mix64(key) & mask;
+
+  while (keys[i]) {
+    if (keys[i] == key)
+      return false; // already known
+    i = (i + 1) & mask;
+  }
+
+  if (count >= limit) {
+    overflow++;
+    return false;
+  }
+
+  keys[i] = key;
+  count++;
+  return true;
+}
+
+bool MacDedup::contains(uint64_t mac) const {
+  const uint64_t key = (mac & 0xFFFFFFFFFFFFULL) | MACDEDUP_USED;
+  uint32_t i = (uint32_t)mac_mix64(key) & mask;
+
+  while (keys[i]) {
+    if (keys[i] == key)
+      return true;
+    i = (i + 1) & mask;
+  }
+  return false;
+}
@@ -283,6 +283,15 @@ void setup() {
   configuration.ble_rssi_threshold = cfg.rssilimit;
   ESP_LOGI(TAG, "BLESCAN: %s", cfg.blescan ? "on" : "off");
 
+  // salt for MAC anonymization, kept over deep sleep
+  anon_init();
+
+  // stationary devices table, kept over warm restarts
+  station_init();
+
+  // site key of exported sketches
+  export_init();
+
   int config_update = libpax_update_config(&configuration);
   if (config_update != 0) {
     ESP_LOGE(TAG, "Error in libpax configuration.");
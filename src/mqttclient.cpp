@@ -108,10 +108,10 @@ void mqtt_client_task(void *param) {
       #endif
 
         char topic[64];  // Increased buffer size to accommodate longer topic
-        snprintf(topic, 64, "%s/%s/%u", MQTT_OUTTOPIC, STRINGIFY(DEVICE_NAME), msg.MessagePort);
+        snprintf(topic, 64, "%s/%s/%u", MQTT_TOPIC(msg.MessagePort), STRINGIFY(DEVICE_NAME), msg.MessagePort);
         #else
         char topic[16];
-        snprintf(topic, 16, "%s/%u", MQTT_OUTTOPIC, msg.MessagePort);
+        snprintf(topic, 16, "%s/%u", MQTT_TOPIC(msg.MessagePort), msg.MessagePort);
         #endif
       
       size_t out_len = 0;
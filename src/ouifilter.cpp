@@ -0,0 +1,18 @@
+#include "ouifilter.h"
+#include "ouitable.h"
+
+// hash functions must match those of shared/ouigen.py
+static inline uint32_t oui_bucket(uint32_t oui) {
+  return (uint32_t)(oui * 0x85EBCA6Bu) >> (32 - OUI_BUCKET_BITS);
+}
+
+static inline uint32_t oui_slot(uint32_t oui, uint16_t disp) {
+  const uint32_t seed = disp * 0x5BD1E995u;
+  return (uint32_t)((oui ^ seed) * 0x9E3779B1u) >> (32 - OUI_TABLE_BITS);
+}
+
+uint8_t oui_lookup(uint32_t oui) {
+  oui &= 0xFFFFFF;
+  const uint32_t e = oui_table[oui_slot(oui, oui_disp[oui_bucket(oui)])];
+  return ((e & 0xFFFFFF) == oui) ? (uint8_t)(e >> 24) : OUI_NONE;
+}
@@ -0,0 +1,28 @@
+// Basic Config
+#include "paxestimate.h"
+#include "configmanager.h"
+
+// Occupancy estimate, linear model over the device counts of a cycle:
+//
+//   pax = c0 + c1 * wifi + c2 * ble + c3 * near + c4 * random
+//
+// near is the number of devices in the rssi band >= PAX_NEAR_RSSI, random
+// the number of devices using a randomized MAC. Like the wifi and ble counts
+// they cover devices above the rssi limit seen since given uptime [seconds],
+// so all terms come from the same population. Coefficients are per site
+// calibration values in cfg.paxcoef, fixed point with 8 fractional bits, set
+// by rcommand.
+uint16_t pax_estimate(const struct count_payload_t *count, uint32_t since) {
+  uint16_t near, random;
+  rssi_counted(since, PAX_NEAR_RSSI, &near, &random);
+
+  const int64_t pax = (int64_t)cfg.paxcoef[PAX_COEF_OFFSET] +
+                      (int64_t)cfg.paxcoef[PAX_COEF_WIFI] * count->wifi_count +
+                      (int64_t)cfg.paxcoef[PAX_COEF_BLE] * count->ble_count +
+                      (int64_t)cfg.paxcoef[PAX_COEF_NEAR] * near +
+                      (int64_t)cfg.paxcoef[PAX_COEF_RANDOM] * random;
+
+  // round to persons, a model can't predict less than nobody
+  const int64_t persons = (pax + 128) / 256;
+  return (persons < 0) ? 0 : ((persons > UINT16_MAX) ? UINT16_MAX : persons);
+}
@@ -6,6 +6,7 @@ PayloadConvert payload(PAYLOAD_BUFFER_SIZE);
 
 PayloadConvert::PayloadConvert(uint8_t size) {
   buffer = (uint8_t *)malloc(size);
+  maxsize = size;
   cursor = 0;
 }
 
@@ -15,6 +16,8 @@ void PayloadConvert::reset(void) { cursor = 0; }
 
 uint8_t PayloadConvert::getSize(void) { return cursor; }
 
+uint8_t PayloadConvert::getCapacity(void) { return maxsize; }
+
 uint8_t *PayloadConvert::getBuffer(void) { return buffer; }
 
 /* ---------------- plain format without special encoding ---------- */
@@ -31,6 +34,139 @@ void PayloadConvert::addCount(uint16_t value, uint8_t snifftype) {
   buffer[cursor++] = lowByte(value);
 }
 
+void PayloadConvert::addCount(randStatus_t value) {
+  buffer[cursor++] = highByte(value.global);
+  buffer[cursor++] = lowByte(value.global);
+  buffer[cursor++] = highByte(value.random);
+  buffer[cursor++] = lowByte(value.random);
+  buffer[cursor++] = highByte(value.rotations);
+  buffer[cursor++] = lowByte(value.rotations);
+}
+
+void PayloadConvert::addCountError(uint16_t value) {
+  buffer[cursor++] = highByte(value);
+  buffer[cursor++] = lowByte(value);
+}
+
+void PayloadConvert::addPaxEstimate(uint16_t value) {
+  buffer[cursor++] = highByte(value);
+  buffer[cursor++] = lowByte(value);
+}
+
+void PayloadConvert::addSmoothedCount(uint16_t value, uint8_t ci) {
+  buffer[cursor++] = highByte(value);
+  buffer[cursor++] = lowByte(value);
+  buffer[cursor++] = ci;
+}
+
+void PayloadConvert::addFlow(uint16_t arrivals, uint16_t departures) {
+  buffer[cursor++] = highByte(arrivals);
+  buffer[cursor++] = lowByte(arrivals);
+  buffer[cursor++] = highByte(departures);
+  buffer[cursor++] = lowByte(departures);
+}
+
+void PayloadConvert::addWindowCounts(uint16_t counts[], uint8_t n) {
+  for (uint8_t i = 0; i < n; i++) {
+    buffer[cursor++] = highByte(counts[i]);
+    buffer[cursor++] = lowByte(counts[i]);
+  }
+}
+
+void PayloadConvert::addRSSIHistogram(uint16_t hist[], uint8_t n) {
+  for (uint8_t i = 0; i < n; i++) {
+    buffer[cursor++] = highByte(hist[i]);
+    buffer[cursor++] = lowByte(hist[i]);
+  }
+}
+
+void PayloadConvert::addZoneCounts(uint16_t counts[], uint8_t n) {
+  for (uint8_t i = 0; i < n; i++) {
+    buffer[cursor++] = highByte(counts[i]);
+    buffer[cursor++] = lowByte(counts[i]);
+  }
+}
+
+void PayloadConvert::addDwellTime(dwellStatus_t value) {
+  buffer[cursor++] = highByte(value.devices);
+  buffer[cursor++] = lowByte(value.devices);
+  buffer[cursor++] = highByte(value.p50);
+  buffer[cursor++] = lowByte(value.p50);
+  buffer[cursor++] = highByte(value.p90);
+  buffer[cursor++] = lowByte(value.p90);
+}
+
+void PayloadConvert::addChannelStats(uint16_t chanmap, ChanHopStats stats[]) {
+  buffer[cursor++] = highByte(chanmap);
+  buffer[cursor++] = lowByte(chanmap);
+  for (uint8_t i = 0; i < __builtin_popcount(chanmap); i++) {
+    const uint16_t newdevs = min(stats[i].newdevs, (uint32_t)UINT16_MAX);
+    buffer[cursor++] = min(stats[i].dwell / 10, 255);
+    buffer[cursor++] = highByte(newdevs);
+    buffer[cursor++] = lowByte(newdevs);
+  }
+}
+
+void PayloadConvert::addSnifferStats(uint32_t pushed[2],
+                                     uint32_t dropped[2]) {
+  const uint32_t v[] = {pushed[0], pushed[1], dropped[0], dropped[1]};
+  for (uint8_t i = 0; i < 4; i++) {
+    buffer[cursor++] = (byte)((v[i] & 0xFF000000) >> 24);
+    buffer[cursor++] = (byte)((v[i] & 0x00FF0000) >> 16);
+    buffer[cursor++] = (byte)((v[i] & 0x0000FF00) >> 8);
+    buffer[cursor++] = (byte)((v[i] & 0x000000FF));
+  }
+}
+
+void PayloadConvert::addStationary(uint16_t tracked, uint16_t excluded,
+                                   uint32_t frames) {
+  buffer[cursor++] = highByte(tracked);
+  buffer[cursor++] = lowByte(tracked);
+  buffer[cursor++] = highByte(excluded);
+  buffer[cursor++] = lowByte(excluded);
+  buffer[cursor++] = (byte)((frames & 0xFF000000) >> 24);
+  buffer[cursor++] = (byte)((frames & 0x00FF0000) >> 16);
+  buffer[cursor++] = (byte)((frames & 0x0000FF00) >> 8);
+  buffer[cursor++] = (byte)((frames & 0x000000FF));
+}
+
+void PayloadConvert::addFrameTypes(frameStats_t stats) {
+  for (uint8_t i = 0; i < FRAME_CLASSES; i++) {
+    buffer[cursor++] = highByte(stats.frames[i]);
+    buffer[cursor++] = lowByte(stats.frames[i]);
+  }
+  for (uint8_t i = 0; i < FRAME_CLASSES; i++) {
+    buffer[cursor++] = highByte(stats.devices[i]);
+    buffer[cursor++] = lowByte(stats.devices[i]);
+  }
+}
+
+void PayloadConvert::addHistory(uint8_t ago, histRecord_t rec[], uint8_t n) {
+  buffer[cursor++] = ago;
+  for (uint8_t i = 0; i < n; i++) {
+    const uint16_t *v[3] = {rec[i].min, rec[i].max, rec[i].mean};
+    for (uint8_t k = 0; k < 3; k++)
+      for (uint8_t s = 0; s < HISTORY_SERIES; s++) {
+        buffer[cursor++] = highByte(v[k][s]);
+        buffer[cursor++] = lowByte(v[k][s]);
+      }
+  }
+}
+
+void PayloadConvert::addSketch(const sketchHeader_t *h, const uint8_t *regs) {
+  cursor += sketch_encode(buffer + cursor, h, regs);
+}
+
+void PayloadConvert::addBLEDuty(uint16_t window, uint16_t interval,
+                                uint16_t duty) {
+  buffer[cursor++] = highByte(window);
+  buffer[cursor++] = lowByte(window);
+  buffer[cursor++] = highByte(interval);
+  buffer[cursor++] = lowByte(interval);
+  buffer[cursor++] = highByte(duty);
+  buffer[cursor++] = lowByte(duty);
+}
+
 void PayloadConvert::addVoltage(uint16_t value) {
   buffer[cursor++] = highByte(value);
   buffer[cursor++] = lowByte(value);
@@ -166,6 +302,98 @@ void PayloadConvert::addCount(uint16_t value, uint8_t snifftype) {
   writeUint16(value);
 }
 
+void PayloadConvert::addCount(randStatus_t value) {
+  writeUint16(value.global);
+  writeUint16(value.random);
+  writeUint16(value.rotations);
+}
+
+void PayloadConvert::addCountError(uint16_t value) { writeUint16(value); }
+
+void PayloadConvert::addPaxEstimate(uint16_t value) { writeUint16(value); }
+
+void PayloadConvert::addSmoothedCount(uint16_t value, uint8_t ci) {
+  writeUint16(value);
+  writeUint8(ci);
+}
+
+void PayloadConvert::addFlow(uint16_t arrivals, uint16_t departures) {
+  writeUint16(arrivals);
+  writeUint16(departures);
+}
+
+void PayloadConvert::addWindowCounts(uint16_t counts[], uint8_t n) {
+  for (uint8_t i = 0; i < n; i++)
+    writeUint16(counts[i]);
+}
+
+void PayloadConvert::addRSSIHistogram(uint16_t hist[], uint8_t n) {
+  for (uint8_t i = 0; i < n; i++)
+    writeUint16(hist[i]);
+}
+
+void PayloadConvert::addZoneCounts(uint16_t counts[], uint8_t n) {
+  for (uint8_t i = 0; i < n; i++)
+    writeUint16(counts[i]);
+}
+
+void PayloadConvert::addDwellTime(dwellStatus_t value) {
+  writeUint16(value.devices);
+  writeUint16(value.p50);
+  writeUint16(value.p90);
+}
+
+void PayloadConvert::addChannelStats(uint16_t chanmap, ChanHopStats stats[]) {
+  writeUint16(chanmap);
+  for (uint8_t i = 0; i < __builtin_popcount(chanmap); i++) {
+    writeUint8(min(stats[i].dwell / 10, 255));
+    writeUint16(min(stats[i].newdevs, (uint32_t)UINT16_MAX));
+  }
+}
+
+void PayloadConvert::addSnifferStats(uint32_t pushed[2],
+                                     uint32_t dropped[2]) {
+  writeUint32(pushed[0]);
+  writeUint32(pushed[1]);
+  writeUint32(dropped[0]);
+  writeUint32(dropped[1]);
+}
+
+void PayloadConvert::addStationary(uint16_t tracked, uint16_t excluded,
+                                   uint32_t frames) {
+  writeUint16(tracked);
+  writeUint16(excluded);
+  writeUint32(frames);
+}
+
+void PayloadConvert::addFrameTypes(frameStats_t stats) {
+  for (uint8_t i = 0; i < FRAME_CLASSES; i++)
+    writeUint16(stats.frames[i]);
+  for (uint8_t i = 0; i < FRAME_CLASSES; i++)
+    writeUint16(stats.devices[i]);
+}
+
+void PayloadConvert::addHistory(uint8_t ago, histRecord_t rec[], uint8_t n) {
+  writeUint8(ago);
+  for (uint8_t i = 0; i < n; i++) {
+    const uint16_t *v[3] = {rec[i].min, rec[i].max, rec[i].mean};
+    for (uint8_t k = 0; k < 3; k++)
+      for (uint8_t s = 0; s < HISTORY_SERIES; s++)
+        writeUint16(v[k][s]);
+  }
+}
+
+void PayloadConvert::addSketch(const sketchHeader_t *h, const uint8_t *regs) {
+  cursor += sketch_encode(buffer + cursor, h, regs);
+}
+
+void PayloadConvert::addBLEDuty(uint16_t window, uint16_t interval,
+                                uint16_t duty) {
+  writeUint16(window);
+  writeUint16(interval);
+  writeUint16(duty);
+}
+
 void PayloadConvert::addVoltage(uint16_t value) { writeUint16(value); }
 
 void PayloadConvert::addConfig(configData_t value) {
@@ -366,6 +594,210 @@ void PayloadConvert::addCount(uint16_t value, uint8_t snifftype) {
   }
 }
 
+void PayloadConvert::addCount(randStatus_t value) {
+  const uint16_t v[3] = {value.global, value.random, value.rotations};
+  for (uint8_t i = 0; i < 3; i++) {
+#if (PAYLOAD_ENCODER == 3)
+    buffer[cursor++] = LPP_RANDMAC_CHANNEL + i;
+#endif
+    buffer[cursor++] =
+        LPP_LUMINOSITY; // workaround since cayenne has no data type meter
+    buffer[cursor++] = highByte(v[i]);
+    buffer[cursor++] = lowByte(v[i]);
+  }
+}
+
+void PayloadConvert::addCountError(uint16_t value) {
+#if (PAYLOAD_ENCODER == 3)
+  buffer[cursor++] = LPP_COUNT_ERROR_CHANNEL;
+#endif
+  buffer[cursor++] =
+      LPP_LUMINOSITY; // workaround since cayenne has no data type meter
+  buffer[cursor++] = highByte(value);
+  buffer[cursor++] = lowByte(value);
+}
+
+void PayloadConvert::addPaxEstimate(uint16_t value) {
+#if (PAYLOAD_ENCODER == 3)
+  buffer[cursor++] = LPP_PAX_ESTIMATE_CHANNEL;
+#endif
+  buffer[cursor++] =
+      LPP_LUMINOSITY; // workaround since cayenne has no data type meter
+  buffer[cursor++] = highByte(value);
+  buffer[cursor++] = lowByte(value);
+}
+
+void PayloadConvert::addSmoothedCount(uint16_t value, uint8_t ci) {
+#if (PAYLOAD_ENCODER == 3)
+  buffer[cursor++] = LPP_SMOOTH_CHANNEL;
+#endif
+  buffer[cursor++] =
+      LPP_LUMINOSITY; // workaround since cayenne has no data type meter
+  buffer[cursor++] = highByte(value);
+  buffer[cursor++] = lowByte(value);
+#if (PAYLOAD_ENCODER == 3)
+  buffer[cursor++] = LPP_SMOOTH_CHANNEL + 1;
+#endif
+  buffer[cursor++] = LPP_DIGITAL_INPUT;
+  buffer[cursor++] = ci;
+}
+
+void PayloadConvert::addFlow(uint16_t arrivals, uint16_t departures) {
+  const uint16_t v[2] = {arrivals, departures};
+  for (uint8_t i = 0; i < 2; i++) {
+#if (PAYLOAD_ENCODER == 3)
+    buffer[cursor++] = LPP_FLOW_CHANNEL + i;
+#endif
+    buffer[cursor++] =
+        LPP_LUMINOSITY; // workaround since cayenne has no data type meter
+    buffer[cursor++] = highByte(v[i]);
+    buffer[cursor++] = lowByte(v[i]);
+  }
+}
+
+void PayloadConvert::addWindowCounts(uint16_t counts[], uint8_t n) {
+  for (uint8_t i = 0; i < n; i++) {
+#if (PAYLOAD_ENCODER == 3)
+    buffer[cursor++] = LPP_WINDOW_CHANNEL + i;
+#endif
+    buffer[cursor++] =
+        LPP_LUMINOSITY; // workaround since cayenne has no data type meter
+    buffer[cursor++] = highByte(counts[i]);
+    buffer[cursor++] = lowByte(counts[i]);
+  }
+}
+
+void PayloadConvert::addRSSIHistogram(uint16_t hist[], uint8_t n) {
+  for (uint8_t i = 0; i < n; i++) {
+#if (PAYLOAD_ENCODER == 3)
+    buffer[cursor++] = LPP_RSSI_CHANNEL + i;
+#endif
+    buffer[cursor++] =
+        LPP_LUMINOSITY; // workaround since cayenne has no data type meter
+    buffer[cursor++] = highByte(hist[i]);
+    buffer[cursor++] = lowByte(hist[i]);
+  }
+}
+
+void PayloadConvert::addZoneCounts(uint16_t counts[], uint8_t n) {
+  for (uint8_t i = 0; i < n; i++) {
+#if (PAYLOAD_ENCODER == 3)
+    buffer[cursor++] = LPP_ZONE_CHANNEL + i;
+#endif
+    buffer[cursor++] =
+        LPP_LUMINOSITY; // workaround since cayenne has no data type meter
+    buffer[cursor++] = highByte(counts[i]);
+    buffer[cursor++] = lowByte(counts[i]);
+  }
+}
+
+void PayloadConvert::addDwellTime(dwellStatus_t value) {
+  const uint16_t v[] = {value.devices, value.p50, value.p90};
+  for (uint8_t i = 0; i < 3; i++) {
+#if (PAYLOAD_ENCODER == 3)
+    buffer[cursor++] = LPP_DWELL_CHANNEL + i;
+#endif
+    buffer[cursor++] =
+        LPP_LUMINOSITY; // workaround since cayenne has no data type meter
+    buffer[cursor++] = highByte(v[i]);
+    buffer[cursor++] = lowByte(v[i]);
+  }
+}
+
+void PayloadConvert::addChannelStats(uint16_t chanmap, ChanHopStats stats[]) {
+  uint8_t i = 0;
+  for (uint8_t c = 0; c < CHANHOP_CHANNELS; c++) {
+    if (!(chanmap & (1 << c)))
+      continue;
+    const uint16_t newdevs = min(stats[i++].newdevs, (uint32_t)UINT16_MAX);
+#if (PAYLOAD_ENCODER == 3)
+    buffer[cursor++] = LPP_HOP_CHANNEL + c;
+#endif
+    buffer[cursor++] =
+        LPP_LUMINOSITY; // workaround since cayenne has no data type meter
+    buffer[cursor++] = highByte(newdevs);
+    buffer[cursor++] = lowByte(newdevs);
+  }
+}
+
+// counters saturate at 65535, cayenne has no 32 bit data type
+void PayloadConvert::addSnifferStats(uint32_t pushed[2],
+                                     uint32_t dropped[2]) {
+  const uint32_t v[] = {pushed[0], pushed[1], dropped[0], dropped[1]};
+  for (uint8_t i = 0; i < 4; i++) {
+    const uint16_t s = (v[i] > UINT16_MAX) ? UINT16_MAX : v[i];
+#if (PAYLOAD_ENCODER == 3)
+    buffer[cursor++] = LPP_SNIFF_CHANNEL + i;
+#endif
+    buffer[cursor++] =
+        LPP_LUMINOSITY; // workaround since cayenne has no data type meter
+    buffer[cursor++] = highByte(s);
+    buffer[cursor++] = lowByte(s);
+  }
+}
+
+void PayloadConvert::addStationary(uint16_t tracked, uint16_t excluded,
+                                   uint32_t frames) {
+  const uint16_t v[] = {tracked, excluded,
+                        (uint16_t)((frames > UINT16_MAX) ? UINT16_MAX : frames)};
+  for (uint8_t i = 0; i < 3; i++) {
+#if (PAYLOAD_ENCODER == 3)
+    buffer[cursor++] = LPP_STATION_CHANNEL + i;
+#endif
+    buffer[cursor++] =
+        LPP_LUMINOSITY; // workaround since cayenne has no data type meter
+    buffer[cursor++] = highByte(v[i]);
+    buffer[cursor++] = lowByte(v[i]);
+  }
+}
+
+void PayloadConvert::addFrameTypes(frameStats_t stats) {
+  const uint16_t *series[2] = {stats.frames, stats.devices};
+  for (uint8_t i = 0; i < 2 * FRAME_CLASSES; i++) {
+    const uint16_t v = series[i / FRAME_CLASSES][i % FRAME_CLASSES];
+#if (PAYLOAD_ENCODER == 3)
+    buffer[cursor++] = LPP_FRAME_CHANNEL + i;
+#endif
+    buffer[cursor++] =
+        LPP_LUMINOSITY; // workaround since cayenne has no data type meter
+    buffer[cursor++] = highByte(v);
+    buffer[cursor++] = lowByte(v);
+  }
+}
+
+// pax of first record only, cayenne channels can't repeat in a packet
+void PayloadConvert::addHistory(uint8_t ago, histRecord_t rec[], uint8_t n) {
+  if (!n)
+    return;
+  const uint16_t v[4] = {ago, rec[0].min[0], rec[0].max[0], rec[0].mean[0]};
+  for (uint8_t i = 0; i < 4; i++) {
+#if (PAYLOAD_ENCODER == 3)
+    buffer[cursor++] = LPP_HISTORY_CHANNEL + i;
+#endif
+    buffer[cursor++] =
+        LPP_LUMINOSITY; // workaround since cayenne has no data type meter
+    buffer[cursor++] = highByte(v[i]);
+    buffer[cursor++] = lowByte(v[i]);
+  }
+}
+
+// raw registers don't map to cayenne data types
+void PayloadConvert::addSketch(const sketchHeader_t *h, const uint8_t *regs) {}
+
+void PayloadConvert::addBLEDuty(uint16_t window, uint16_t interval,
+                                uint16_t duty) {
+  const uint16_t v[] = {window, interval, duty};
+  for (uint8_t i = 0; i < 3; i++) {
+#if (PAYLOAD_ENCODER == 3)
+    buffer[cursor++] = LPP_BLEDUTY_CHANNEL + i;
+#endif
+    buffer[cursor++] =
+        LPP_LUMINOSITY; // workaround since cayenne has no data type meter
+    buffer[cursor++] = highByte(v[i]);
+    buffer[cursor++] = lowByte(v[i]);
+  }
+}
+
 void PayloadConvert::addVoltage(uint16_t value) {
   uint16_t volt = value / 10;
 #if (PAYLOAD_ENCODER == 3)
@@ -0,0 +1,77 @@
+#include <string.h>
+
+#include "presence.h"
+
+PresenceTable::PresenceTable(presenceEntry_t *slab, uint32_t sets,
+                             uint16_t threshold, uint8_t gap)
+    : entry(slab), nsets(sets ? sets : 1), threshold(threshold), gap(gap) {}
+
+void PresenceTable::clear(void) {
+  memset(entry, 0, capacity() * sizeof(presenceEntry_t));
+}
+
+bool PresenceTable::seen(uint32_t tag) {
+  tag = tag ? tag : 1;
+  presenceEntry_t *set = entry + (tag & (nsets - 1)) * PRESENCE_WAYS;
+  presenceEntry_t *victim = set;
+
+  for (uint8_t w = 0; w < PRESENCE_WAYS; w++) {
+    presenceEntry_t *e = set + w;
+    if (e->tag == tag) {
+      e->flags |= PRESENCE_SEEN;
+      return e->flags & PRESENCE_EXCLUDED;
+    }
+    if (!victim->tag)
+      continue; // keep first free entry as victim
+    if (!e->tag || (e->idle > victim->idle) ||
+        ((e->idle == victim->idle) && (e->present < victim->present)))
+      victim = e;
+  }
+
+  victim->tag = tag;
+  victim->present = 0;
+  victim->idle = 0;
+  victim->flags = PRESENCE_SEEN;
+  return false;
+}
+
+void PresenceTable::age(uint16_t minutes) {
+  for (uint32_t i = 0; i < capacity(); i++) {
+    presenceEntry_t *e = entry + i;
+    if (!e->tag)
+      continue;
+
+    if (e->flags & PRESENCE_SEEN)
+      e->idle = 0;
+    else
+      e->idle = (e->idle + minutes > UINT8_MAX) ? UINT8_MAX : e->idle + minutes;
+    e->flags &= ~PRESENCE_SEEN;
+
+    // a gap ends continuous presence, device starts over when it returns.
+    // Excluded devices are kept until idle saturates, so infrastructure
+    // switched off for a while stays excluded.
+    if (e->idle > gap) {
+      if (!(e->flags & PRESENCE_EXCLUDED) || (e->idle == UINT8_MAX))
+        e->tag = 0;
+      continue;
+    }
+    e->present = (e->present + minutes > UINT16_MAX) ? UINT16_MAX
+                                                     : e->present + minutes;
+    if (e->present >= threshold)
+      e->flags |= PRESENCE_EXCLUDED;
+  }
+}
+
+uint32_t PresenceTable::size(void) const {
+  uint32_t n = 0;
+  for (uint32_t i = 0; i < capacity(); i++)
+    n += (entry[i].tag != 0);
+  return n;
+}
+
+uint32_t PresenceTable::excluded(void) const {
+  uint32_t n = 0;
+  for (uint32_t i = 0; i < capacity(); i++)
+    n += entry[i].tag && (entry[i].flags & PRESENCE_EXCLUDED);
+  return n;
+}
@@ -0,0 +1,67 @@
+// Basic Config
+#include "randmac.h"
+#include "reset.h"
+
+#if (RANDMAC_COUNT)
+
+// first and last sighting per device passing the sniffer filters, value is
+// true for a randomized MAC address
+static DeviceCache<bool, RANDMAC_TABLE_SETS> randTable;
+static portMUX_TYPE randMux = portMUX_INITIALIZER_UNLOCKED;
+
+void randmac_add(uint64_t key, bool random, uint32_t now) {
+
+  portENTER_CRITICAL(&randMux);
+  randTable.lookup(key, now)->value = random;
+  portEXIT_CRITICAL(&randMux);
+}
+
+// called at a salt rotation, all devices get new keys, which would look like
+// MAC rotations. The next cycle has no previous one to compare with and
+// reports no rotations.
+void randmac_clear(void) {
+  portENTER_CRITICAL(&randMux);
+  randTable.clear();
+  portEXIT_CRITICAL(&randMux);
+}
+
+// devices by MAC type seen in the cycle starting at given uptime [seconds],
+// and the rotation estimate of this cycle of given length [seconds]. A phone
+// rotating its MAC shows up as a randomized MAC which went silent after the
+// previous cycle plus one which appeared in this cycle. Thus the smaller of
+// both numbers estimates rotations, the excess are real arrivals or
+// departures.
+void randmac_count(randStatus_t *status, uint32_t since, uint32_t cycle) {
+  const uint32_t before = (since > cycle) ? since - cycle : 0;
+  uint32_t global = 0, random = 0, arrived = 0, departed = 0;
+
+  portENTER_CRITICAL(&randMux);
+  randTable.forEach([&](DeviceCache<bool, RANDMAC_TABLE_SETS>::Entry &e) {
+    if (e.last >= since) {
+      if (!e.value)
+        global++;
+      else {
+        random++;
+        if (e.first >= since)
+          arrived++;
+      }
+    } else if (e.value && (e.last >= before))
+      departed++;
+  });
+  portEXIT_CRITICAL(&randMux);
+
+  const uint32_t rotations = (arrived < departed) ? arrived : departed;
+  status->global = (global > UINT16_MAX) ? UINT16_MAX : global;
+  status->random = (random > UINT16_MAX) ? UINT16_MAX : random;
+  status->rotations = (rotations > UINT16_MAX) ? UINT16_MAX : rotations;
+}
+
+#else
+
+void randmac_add(uint64_t key, bool random, uint32_t now) {}
+void randmac_clear(void) {}
+void randmac_count(randStatus_t *status, uint32_t since, uint32_t cycle) {
+  status->global = status->random = status->rotations = 0;
+}
+
+#endif
@@ -50,14 +50,13 @@ void set_reset(uint8_t val[]) {
 }
 
 void set_rssi(uint8_t val[]) {
+  // limit is negative and compared to int8 rssi values
+  if (val[0] > 128) {
+    ESP_LOGW(TAG, "Remote command: RSSI limit -%u dBm out of range", val[0]);
+    return;
+  }
   cfg.rssilimit = val[0] * -1;
-  libpax_counter_stop();
-  libpax_config_t current_config;
-  libpax_get_current_config(&current_config);
-  current_config.wifi_rssi_threshold = cfg.rssilimit;
-  current_config.ble_rssi_threshold = cfg.rssilimit;
-  libpax_update_config(&current_config);
-  init_libpax();
+  live_commit();
   ESP_LOGI(TAG, "Remote command: set RSSI limit to %hd", cfg.rssilimit);
 }
 
@@ -68,8 +67,7 @@ void set_sendcycle(uint8_t val[]) {
   cfg.sendcycle = val[0];
   ESP_LOGI(TAG, "Remote command: set send cycle to %u seconds",
            cfg.sendcycle * 2);
-  libpax_counter_stop();
-  init_libpax();
+  live_commit(); // takes effect after current send cycle
 }
 
 void set_sleepcycle(uint8_t val[]) {
@@ -87,13 +85,9 @@ void set_wakesync(uint8_t val[]) {
 
 void set_wifichancycle(uint8_t val[]) {
   cfg.wifichancycle = val[0];
-  libpax_counter_stop();
-  libpax_config_t current_config;
-  libpax_get_current_config(&current_config);
 
   if (cfg.wifichancycle == 0) {
     ESP_LOGI(TAG, "Remote command: set Wifi channel hopping to off");
-    current_config.wifi_channel_map = WIFI_CHANNEL_1;
   } else {
     ESP_LOGI(
         TAG,
@@ -101,30 +95,22 @@ void set_wifichancycle(uint8_t val[]) {
         cfg.wifichancycle / float(100));
   }
 
-  current_config.wifi_channel_switch_interval = cfg.wifichancycle;
-  libpax_update_config(&current_config);
-  init_libpax();
+  live_commit();
 }
 
 void set_wifichanmap(uint8_t val[]) {
   // swap byte order from msb to lsb, note: this is a platform dependent hack
   cfg.wifichanmap = __builtin_bswap16(*(uint16_t *)(val));
-  libpax_counter_stop();
-  libpax_config_t current_config;
-  libpax_get_current_config(&current_config);
-  current_config.wifi_channel_map = cfg.wifichanmap;
-  libpax_update_config(&current_config);
-  init_libpax();
+  ESP_LOGI(TAG, "Remote command: set Wifi channel map to 0x%04X",
+           cfg.wifichanmap);
+  live_commit();
 }
 
 void set_blescantime(uint8_t val[]) {
   cfg.blescantime = val[0];
-  libpax_counter_stop();
-  libpax_config_t current_config;
-  libpax_get_current_config(&current_config);
-  current_config.blescantime = cfg.blescantime;
-  libpax_update_config(&current_config);
-  init_libpax();
+  ESP_LOGI(TAG, "Remote command: set BLE scan time to %u seconds",
+           cfg.blescantime);
+  live_commit();
 }
 
 void set_countmode(uint8_t val[]) {
@@ -141,14 +127,17 @@ void set_countmode(uint8_t val[]) {
     cfg.countermode = 2;
     ESP_LOGI(TAG, "Remote command: set counter mode to cyclic confirmed");
     break;
+  case 3: // cumulative, counted by fixed size sketch
+    cfg.countermode = 3;
+    ESP_LOGI(TAG, "Remote command: set counter mode to cumulative sketch");
+    break;
   default: // invalid parameter
     ESP_LOGW(
         TAG,
         "Remote command: set counter mode called with invalid parameter(s)");
     return;
   }
-  libpax_counter_stop();
-  init_libpax(); // re-inits counter mode from cfg.countermode
+  live_restart(); // re-inits counter mode from cfg.countermode
 }
 
 void set_screensaver(uint8_t val[]) {
@@ -219,11 +208,7 @@ void set_sensor(uint8_t val[]) {
 #endif
 }
 
-uint64_t macConvert(uint8_t *paddr) {
-  uint64_t *mac;
-  mac = (uint64_t *)paddr;
-  return (__builtin_bswap64(*mac) >> 16);
-}
+uint64_t macConvert(uint8_t *paddr) { return mac_to_u64(paddr); }
 
 void set_loradr(uint8_t val[]) {
 #if (HAS_LORA)
@@ -259,24 +244,14 @@ void set_loraadr(uint8_t val[]) {
 void set_blescan(uint8_t val[]) {
   ESP_LOGI(TAG, "Remote command: set BLE scanner to %s", val[0] ? "on" : "off");
   cfg.blescan = val[0] ? 1 : 0;
-  libpax_counter_stop();
-  libpax_config_t current_config;
-  libpax_get_current_config(&current_config);
-  current_config.blecounter = cfg.blescan;
-  libpax_update_config(&current_config);
-  init_libpax();
+  live_commit();
 }
 
 void set_wifiscan(uint8_t val[]) {
   ESP_LOGI(TAG, "Remote command: set WIFI scanner to %s",
            val[0] ? "on" : "off");
   cfg.wifiscan = val[0] ? 1 : 0;
-  libpax_counter_stop();
-  libpax_config_t current_config;
-  libpax_get_current_config(&current_config);
-  current_config.wificounter = cfg.wifiscan;
-  libpax_update_config(&current_config);
-  init_libpax();
+  live_commit();
 }
 
 void set_wifiant(uint8_t val[]) {
@@ -368,6 +343,90 @@ void get_batt(uint8_t val[]) {
 #endif
 }
 
+void get_windows(uint8_t val[]) {
+  ESP_LOGI(TAG, "Remote command: get sliding window counts");
+  uint16_t windows[WINDOW_HORIZONS];
+  window_count(windows);
+  payload.reset();
+  payload.addWindowCounts(windows, WINDOW_HORIZONS);
+  SendPayload(WINDOWPORT);
+}
+
+void get_rssi(uint8_t val[]) {
+  ESP_LOGI(TAG, "Remote command: get rssi histogram");
+  uint16_t hist[RSSI_BUCKETS];
+  rssi_histogram(hist, sendcycle_start());
+  payload.reset();
+  payload.addRSSIHistogram(hist, RSSI_BUCKETS);
+  SendPayload(RSSIPORT);
+}
+
+void get_zones(uint8_t val[]) {
+  ESP_LOGI(TAG, "Remote command: get rssi zone counts");
+  uint16_t zones[RSSI_ZONES];
+  rssi_zones(zones, sendcycle_start());
+  payload.reset();
+  payload.addZoneCounts(zones, RSSI_ZONES);
+  SendPayload(ZONEPORT);
+}
+
+void get_history(uint8_t val[]) {
+  ESP_LOGI(TAG, "Remote command: get history of %u hours from %u hours ago",
+           val[1], val[0]);
+  history_send(val[0], val[1]);
+}
+
+void get_dwell(uint8_t val[]) {
+  ESP_LOGI(TAG, "Remote command: get dwell time");
+  static uint16_t times[DWELL_ENTRIES]; // scratch, used by rcmd task only
+  dwellStatus_t dwell;
+  dwell_percentiles(&dwell, sendcycle_start(), times);
+  payload.reset();
+  payload.addDwellTime(dwell);
+  SendPayload(DWELLPORT);
+}
+
+void get_chanstats(uint8_t val[]) {
+  ESP_LOGI(TAG, "Remote command: get wifi channel statistics");
+  ChanHopStats stats[CHANHOP_CHANNELS];
+  const uint16_t chanmap = hop_stats(stats);
+  for (uint8_t i = 0; i < __builtin_popcount(chanmap); i++)
+    ESP_LOGD(TAG, "%u frames, %u new devices, %u/s, dwell %ums",
+             stats[i].frames, stats[i].newdevs, stats[i].rate,
+             stats[i].dwell);
+  payload.reset();
+  payload.addChannelStats(chanmap, stats);
+  SendPayload(CHANNELPORT);
+}
+
+void get_bleduty(uint8_t val[]) {
+  ESP_LOGI(TAG, "Remote command: get BLE scan duty");
+  uint16_t window, interval, duty;
+  bleadapt_status(&window, &interval, &duty);
+  payload.reset();
+  payload.addBLEDuty(window, interval, duty);
+  SendPayload(BLEDUTYPORT);
+}
+
+void get_sniffstats(uint8_t val[]) {
+  ESP_LOGI(TAG, "Remote command: get sniffer ring statistics");
+  uint32_t pushed[2], dropped[2];
+  sniffer_stats(pushed, dropped);
+  payload.reset();
+  payload.addSnifferStats(pushed, dropped);
+  SendPayload(SNIFFPORT);
+}
+
+void get_stationary(uint8_t val[]) {
+  ESP_LOGI(TAG, "Remote command: get stationary devices");
+  uint16_t tracked, excluded;
+  uint32_t frames;
+  station_stats(&tracked, &excluded, &frames);
+  payload.reset();
+  payload.addStationary(tracked, excluded, frames);
+  SendPayload(STATIONPORT);
+}
+
 void get_time(uint8_t val[]) {
   ESP_LOGI(TAG, "Remote command: get time");
   time_t t = time(NULL);
@@ -395,6 +454,35 @@ void set_flush(uint8_t val[]) {
   // used to open receive window on LoRaWAN class a nodes
 }
 
+void set_paxcoef(uint8_t val[]) {
+  if (val[0] >= PAX_COEFS) {
+    ESP_LOGW(TAG, "Remote command: set pax coefficient called with invalid "
+                  "index %u",
+             val[0]);
+    return;
+  }
+  // swap byte order from msb to lsb, note: this is a platform dependent hack
+  cfg.paxcoef[val[0]] = (int16_t)__builtin_bswap16(*(uint16_t *)(val + 1));
+  ESP_LOGI(TAG, "Remote command: set pax coefficient %u to %d/256", val[0],
+           cfg.paxcoef[val[0]]);
+}
+
+// thresholds are given as positive dBm like the rssi limit, 0 = unused
+void set_rssizones(uint8_t val[]) {
+  for (uint8_t i = 0; i < RSSI_ZONES; i++)
+    cfg.rssizone[i] = (val[i] > 128) ? -128 : val[i] * -1;
+  live_commit();
+  ESP_LOGI(TAG, "Remote command: set RSSI zones to %d/%d/%d/%d dBm",
+           cfg.rssizone[0], cfg.rssizone[1], cfg.rssizone[2],
+           cfg.rssizone[3]);
+}
+
+void set_sitekey(uint8_t val[]) {
+  memcpy(cfg.sitekey, val, sizeof(cfg.sitekey));
+  export_init();
+  ESP_LOGI(TAG, "Remote command: set site key of sketch export");
+}
+
 void set_loadconfig(uint8_t val[]) {
   ESP_LOGI(TAG, "Remote command: load config from NVRAM");
   loadConfig();
@@ -422,22 +510,148 @@ static const cmd_t table[] = {
     {0x16, set_batt, 1},          {0x17, set_wifiscan, 1},
     {0x18, set_flush, 0},         {0x19, set_sleepcycle, 2},
     {0x20, set_loadconfig, 0},    {0x21, set_saveconfig, 0},
+    {0x23, set_paxcoef, 3},       {0x24, set_rssizones, 4},
+    {0x25, set_sitekey, 16},
     {0x80, get_config, 0},        {0x81, get_status, 0},
     {0x83, get_batt, 0},          {0x84, get_gps, 0},
     {0x85, get_bme, 0},           {0x86, get_time, 0},
     {0x87, set_timesync, 0},      {0x88, set_time, 4},
+    {0x89, get_windows, 0},       {0x8a, get_rssi, 0},
+    {0x8b, get_dwell, 0},         {0x8c, get_chanstats, 0},
+    {0x8d, get_bleduty, 0},       {0x8e, get_sniffstats, 0},
+    {0x8f, get_stationary, 0},    {0x90, get_zones, 0},
+    {0x91, get_history, 2},
     {0x99, set_flush, 0}};
 
 static const uint8_t cmdtablesize =
     sizeof(table) / sizeof(table[0]); // number of commands in command table
 
+static const cmd_t *rcmd_lookup(const uint8_t opcode) {
+  for (uint8_t i = 0; i < cmdtablesize; i++)
+    if (table[i].opcode == opcode)
+      return table + i;
+  return NULL;
+}
+
+// configuration commands which may be part of a transaction
+static const uint8_t txn_opcodes[] = {
+    0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x0a, 0x0b, 0x0c, 0x0d,
+    0x0e, 0x0f, 0x10, 0x11, 0x13, 0x14, 0x15, 0x16, 0x17, 0x19, 0x21,
+    0x23, 0x24, 0x25};
+
+static bool txn_allowed(const uint8_t opcode) {
+  for (uint8_t i = 0; i < sizeof(txn_opcodes); i++)
+    if (txn_opcodes[i] == opcode)
+      return true;
+  return false;
+}
+
+// parameter checks, same limits as the command functions apply
+static bool txn_valid(const uint8_t opcode, const uint8_t val[]) {
+  switch (opcode) {
+  case 0x01: // rssi limit, negated it must fit int8
+    return val[0] <= 128;
+  case 0x02: // counter mode
+    return val[0] <= 3;
+#if (HAS_LORA)
+  case 0x05: // lora datarate
+    return validDR(val[0]);
+#endif
+  case 0x0a: // send cycle
+    return val[0] >= 5;
+  case 0x10: // rgb luminosity
+    return val[0] <= 100;
+  case 0x11: // wifi channel map
+    return val[0] || val[1];
+  case 0x13: // sensor number
+    return (val[0] >= 1) && (val[0] <= 3);
+  case 0x23: // pax coefficient index
+    return val[0] < PAX_COEFS;
+  default:
+    return true;
+  }
+}
+
+// all commands of the buffer are checked before any is executed, then they
+// are executed as one batch: sniffer reconfigures once, config is saved to
+// NVRAM once if it changed, one status uplink on TXNPORT reports the result:
+// status, commands committed, opcode and index of the failing command
+static void rcmd_transaction(const uint8_t cmd[], const uint8_t cmdlength) {
+  if (cmdlength == 0) {
+    ESP_LOGW(TAG, "Remote command transaction is empty, ignored");
+    return;
+  }
+
+  const cmd_t *staged[cmdlength];
+  uint8_t foundcmd[cmdlength], argpos[cmdlength];
+  uint8_t n = 0, cursor = 0, failed = 0;
+  uint8_t status = TXN_OK;
+  bool save = false;
+
+  while (cursor < cmdlength) {
+    const cmd_t *c = rcmd_lookup(cmd[cursor]);
+    failed = cmd[cursor];
+    if (!c)
+      status = TXN_UNKNOWN;
+    else if (!txn_allowed(c->opcode))
+      status = TXN_NOT_ALLOWED;
+    else if (cursor + 1 + c->params > cmdlength)
+      status = TXN_MISSING;
+    else if (!txn_valid(c->opcode, cmd + cursor + 1))
+      status = TXN_INVALID;
+    if (status != TXN_OK)
+      break;
+    staged[n] = c;
+    argpos[n++] = cursor + 1;
+    cursor += 1 + c->params;
+  }
+
+  if (status == TXN_OK) {
+    failed = 0;
+    const configData_t before = cfg;
+    live_begin();
+    for (uint8_t i = 0; i < n; i++) {
+      if (staged[i]->opcode == 0x21) { // save config, done once below
+        save = true;
+        continue;
+      }
+      memcpy(foundcmd, cmd + argpos[i], staged[i]->params);
+      staged[i]->func(foundcmd);
+    }
+    live_end();
+    if (save || memcmp(&before, &cfg, sizeof(cfg)))
+      saveConfig(false);
+    ESP_LOGI(TAG, "Remote command transaction: %u commands committed", n);
+  } else
+    ESP_LOGW(TAG,
+             "Remote command transaction rejected at command %u (x%02X), "
+             "error %u, nothing applied",
+             n, failed, status);
+
+  // on reject nothing is committed, n is the index of the failing command
+  payload.reset();
+  payload.addByte(status);
+  payload.addByte(status == TXN_OK ? n : 0);
+  payload.addByte(failed);
+  payload.addByte(status == TXN_OK ? 0 : n);
+  SendPayload(TXNPORT);
+}
+
 // check and execute remote command
 void rcmd_execute(const uint8_t cmd[], const uint8_t cmdlength) {
   if (cmdlength == 0)
     return;
 
+  if (cmd[0] == RCMD_TRANSACTION) {
+    rcmd_transaction(cmd + 1, cmdlength - 1);
+    return;
+  }
+
   uint8_t foundcmd[cmdlength], cursor = 0;
 
+  // sniffer settings of all commands take effect together
+  live_begin();
+
   while (cursor < cmdlength) {
     int i = cmdtablesize;
     while (i--) {
@@ -463,6 +677,8 @@ void rcmd_execute(const uint8_t cmd[], const uint8_t cmdlength) {
       break;
     }
   } // command parsing loop
+
+  live_end();
 } //  rcmd_execute()
 
 // remote command processing task
@@ -1,5 +1,7 @@
 #include "globals.h"
 #include "reset.h"
+#include "libpax_helpers.h"
+#include "sniffer.h"
 
 // Conversion factor for micro seconds to seconds
 #define uS_TO_S_FACTOR 1000000ULL
@@ -16,6 +18,7 @@ struct timeval sleep_stop_time;
 void reset_rtc_vars(void) {
   RTC_runmode = RUNMODE_POWERCYCLE;
   RTC_restarts = 0;
+  station_invalidate();
 }
 
 #if (HAS_TIME)
@@ -118,6 +121,9 @@ void enter_deepsleep(uint32_t wakeup_sec, gpio_num_t wakeup_gpio) {
     wakeup_gpio = GPIO_NUM_MAX;
   // stop further enqueuing of senddata and MAC processing
   libpax_counter_stop();
+  sniffer_stop();
+  // seal cumulative sketch count in RTC memory, nothing adds to it anymore
+  sketch_save();
 
   // switch off any power consuming hardware
 #if (HAS_SDS011)
@@ -0,0 +1,114 @@
+// Basic Config
+#include "rssitrack.h"
+#include "reset.h"
+
+// per device rssi, smoothed by an exponentially weighted moving average
+// stored as fixed point with 4 fractional bits, and the MAC address type
+static DeviceCache<rssiValue_t, RSSI_TABLE_SETS> rssiTable;
+static portMUX_TYPE rssiMux = portMUX_INITIALIZER_UNLOCKED;
+
+// rssi zone of each rssi value [dBm], indexed by rssi + 128
+static uint8_t zoneMap[256];
+
+// now is uptime [seconds] of the detection, counted if the frame passed the
+// rssi limit
+void rssi_add(uint64_t key, int8_t rssi, bool random, bool counted,
+              uint32_t now) {
+  bool isnew;
+
+  portENTER_CRITICAL(&rssiMux);
+  rssiValue_t *v = &rssiTable.lookup(key, now, &isnew)->value;
+  if (isnew) {
+    v->ewma = rssi * 16;
+    v->counted = 0;
+  } else
+    v->ewma += (rssi * 16 - v->ewma) >> RSSI_EWMA_SHIFT;
+  v->random = random;
+  v->zone = zoneMap[v->ewma / 16 + 128];
+  if (counted)
+    v->counted = now ? now : 1;
+  portEXIT_CRITICAL(&rssiMux);
+}
+
+// mean rssi of all devices seen since given uptime [seconds], 0 if none
+int8_t rssi_mean(uint32_t since) {
+  int32_t sum = 0, n = 0;
+
+  portENTER_CRITICAL(&rssiMux);
+  rssiTable.forEach([&](DeviceCache<rssiValue_t, RSSI_TABLE_SETS>::Entry &e) {
+    if (e.last >= since) {
+      sum += e.value.ewma;
+      n++;
+    }
+  });
+  portEXIT_CRITICAL(&rssiMux);
+
+  return n ? (int8_t)(sum / n / 16) : 0;
+}
+
+// histogram of device rssi for all devices seen since given uptime [seconds]
+void rssi_histogram(uint16_t hist[RSSI_BUCKETS], uint32_t since) {
+  memset(hist, 0, RSSI_BUCKETS * sizeof(hist[0]));
+
+  portENTER_CRITICAL(&rssiMux);
+  rssiTable.forEach([&](DeviceCache<rssiValue_t, RSSI_TABLE_SETS>::Entry &e) {
+    const uint8_t b = rssi_bucket(e.value.ewma / 16);
+    if ((e.last >= since) && (hist[b] < UINT16_MAX))
+      hist[b]++;
+  });
+  portEXIT_CRITICAL(&rssiMux);
+}
+
+// devices which passed the rssi limit since given uptime [seconds], as in
+// the wifi and ble counts: near ones with rssi >= nearrssi, and those with
+// randomized MAC
+void rssi_counted(uint32_t since, int16_t nearrssi, uint16_t *near,
+                  uint16_t *random) {
+  uint32_t n = 0, r = 0;
+
+  portENTER_CRITICAL(&rssiMux);
+  rssiTable.forEach([&](DeviceCache<rssiValue_t, RSSI_TABLE_SETS>::Entry &e) {
+    if (!e.value.counted || (e.value.counted < since))
+      return;
+    if (e.value.ewma / 16 >= nearrssi) // rounded as in rssi_histogram()
+      n++;
+    if (e.value.random)
+      r++;
+  });
+  portEXIT_CRITICAL(&rssiMux);
+
+  *near = (n > UINT16_MAX) ? UINT16_MAX : n;
+  *random = (r > UINT16_MAX) ? UINT16_MAX : r;
+}
+
+// zone i holds devices at or above threshold i and below all stronger
+// thresholds, thresholds may be given in any order, 0 marks an unused one.
+// Devices keep their zone until they are seen again.
+void rssi_zones_config(const int8_t thresholds[RSSI_ZONES]) {
+  uint8_t map[256];
+  for (int16_t rssi = -128; rssi < 128; rssi++) {
+    uint8_t zone = RSSI_ZONE_NONE;
+    for (uint8_t i = 0; i < RSSI_ZONES; i++)
+      if (thresholds[i] && (rssi >= thresholds[i]) &&
+          ((zone == RSSI_ZONE_NONE) || (thresholds[i] > thresholds[zone])))
+        zone = i;
+    map[rssi + 128] = zone;
+  }
+
+  portENTER_CRITICAL(&rssiMux);
+  memcpy(zoneMap, map, sizeof(zoneMap));
+  portEXIT_CRITICAL(&rssiMux);
+}
+
+// number of devices per rssi zone seen since given uptime [seconds]
+void rssi_zones(uint16_t counts[RSSI_ZONES], uint32_t since) {
+  memset(counts, 0, RSSI_ZONES * sizeof(counts[0]));
+
+  portENTER_CRITICAL(&rssiMux);
+  rssiTable.forEach([&](DeviceCache<rssiValue_t, RSSI_TABLE_SETS>::Entry &e) {
+    const uint8_t z = e.value.zone;
+    if ((e.last >= since) && (z < RSSI_ZONES) && (counts[z] < UINT16_MAX))
+      counts[z]++;
+  });
+  portEXIT_CRITICAL(&rssiMux);
+}
@@ -70,6 +70,39 @@ void sendData() {
 #endif
   struct count_payload_t count =
       count_from_libpax; // copy values from global libpax var
+  uint16_t count_error = 0;
+#if (WINDOW_COUNTS)
+  uint16_t windows[WINDOW_HORIZONS];
+#endif
+#if (RSSI_HISTOGRAM)
+  uint16_t rssi_hist[RSSI_BUCKETS];
+#endif
+#if (RSSI_ZONE_COUNT)
+  uint16_t zones[RSSI_ZONES];
+#endif
+#if (DWELL_TIME)
+  static uint16_t dwellTimes[DWELL_ENTRIES]; // scratch, used by this task only
+  dwellStatus_t dwell;
+#endif
+#if (RANDMAC_COUNT)
+  randStatus_t randmac;
+#endif
+  frameStats_t frames;
+  if (cfg.countermode == 3)
+    sketch_count(&count, &count_error);
+#if (COUNT_SMOOTHING)
+  uint16_t smooth_count = 0;
+  uint8_t smooth_ci = 0;
+  if (bitmask & COUNT_DATA)
+    count_smooth(&count, count_error, &smooth_count, &smooth_ci);
+#endif
+#if (FLOW_COUNT)
+  // intervals follow send cycles, also if counts are not sent
+  uint16_t arrivals, departures;
+  flow_cycle(&arrivals, &departures);
+#endif
+  history_add(&count);
+  export_send();
   ESP_LOGD(TAG, "Sending count results: pax=%d / wifi=%d / ble=%d", count.pax,
            count.wifi_count, count.ble_count);
 
@@ -82,6 +115,21 @@ void sendData() {
           payload.addCount(count.wifi_count, MAC_SNIFF_WIFI);
           if (cfg.blescan)
               payload.addCount(count.ble_count, MAC_SNIFF_BLE);
+          if (cfg.countermode == 3)
+              payload.addCountError(count_error);
+#if (PAX_ESTIMATE)
+          payload.addPaxEstimate(pax_estimate(&count, sendcycle_start()));
+#endif
+#if (COUNT_SMOOTHING)
+          payload.addSmoothedCount(smooth_count, smooth_ci);
+#endif
+#if (RANDMAC_COUNT)
+          randmac_count(&randmac, sendcycle_start(), cfg.sendcycle * 2);
+          payload.addCount(randmac);
+#endif
+#if (FLOW_COUNT)
+          payload.addFlow(arrivals, departures);
+#endif
 #endif
 
 #if (HAS_GPS)
@@ -100,6 +148,21 @@ void sendData() {
           payload.addCount(count.wifi_count, MAC_SNIFF_WIFI);
           if (cfg.blescan)
               payload.addCount(count.ble_count, MAC_SNIFF_BLE);
+          if (cfg.countermode == 3)
+              payload.addCountError(count_error);
+#if (PAX_ESTIMATE)
+          payload.addPaxEstimate(pax_estimate(&count, sendcycle_start()));
+#endif
+#if (COUNT_SMOOTHING)
+          payload.addSmoothedCount(smooth_count, smooth_ci);
+#endif
+#if (RANDMAC_COUNT)
+          randmac_count(&randmac, sendcycle_start(), cfg.sendcycle * 2);
+          payload.addCount(randmac);
+#endif
+#if (FLOW_COUNT)
+          payload.addFlow(arrivals, departures);
+#endif
 #endif
 
 #if (HAS_SDS011)
@@ -121,8 +184,43 @@ void sendData() {
 #endif // HAS_SDCARD
 
           SendPayload(COUNTERPORT);
+
+#if (WINDOW_COUNTS)
+          window_count(windows);
+          payload.reset();
+          payload.addWindowCounts(windows, WINDOW_HORIZONS);
+          SendPayload(WINDOWPORT);
+#endif
+
+#if (RSSI_HISTOGRAM)
+          rssi_histogram(rssi_hist, sendcycle_start());
+          payload.reset();
+          payload.addRSSIHistogram(rssi_hist, RSSI_BUCKETS);
+          SendPayload(RSSIPORT);
+#endif
+
+#if (RSSI_ZONE_COUNT)
+          rssi_zones(zones, sendcycle_start());
+          payload.reset();
+          payload.addZoneCounts(zones, RSSI_ZONES);
+          SendPayload(ZONEPORT);
+#endif
+
+#if (DWELL_TIME)
+          dwell_percentiles(&dwell, sendcycle_start(), dwellTimes);
+          payload.reset();
+          payload.addDwellTime(dwell);
+          SendPayload(DWELLPORT);
+#endif
           break; // case COUNTDATA
 
+      case FRAMES_DATA:
+          frame_stats(&frames);
+          payload.reset();
+          payload.addFrameTypes(frames);
+          SendPayload(FRAMEPORT);
+          break;
+
 #if (HAS_BME)
       case MEMS_DATA:
           payload.reset();
@@ -182,6 +280,19 @@ void sendData() {
       bitmask &= ~mask;
       mask <<= 1;
   } // while (bitmask)
+
+  // frame breakdown covers one send cycle, also if it was not sent
+  if (!(cfg.payloadmask & FRAMES_DATA))
+    frame_reset();
+
+  // a changed send cycle starts now
+  live_sendcycle();
+  // salt rotation takes effect for the next cycle, tables comparing devices
+  // across cycles start over, as their keys change
+  if (anon_update()) {
+    dwell_clear();
+    randmac_clear();
+  }
 } // sendData()
 
 void flushQueues(void) {
@@ -0,0 +1,82 @@
+#include "siphash.h"
+
+#define ROTL(x, b) (uint64_t)(((x) << (b)) | ((x) >> (64 - (b))))
+
+#define SIPROUND                                                               \
+  do {                                                                         \
+    v0 += v1;                                                                  \
+    v1 = ROTL(v1, 13);                                                         \
+    v1 ^= v0;                                                                  \
+    v0 = ROTL(v0, 32);                                                         \
+    v2 += v3;                                                                  \
+    v3 = ROTL(v3, 16);                                                         \
+    v3 ^= v2;                                                                  \
+    v0 += v3;                                                                  \
+    v3 = ROTL(v3, 21);                                                         \
+    v3 ^= v0;                                                                  \
+    v2 += v1;                                                                  \
+    v1 = ROTL(v1, 17);                                                         \
+    v1 ^= v2;                                                                  \
+    v2 = ROTL(v2, 32);                                                         \
+  } while (0)
+
+#define SIPINIT(key)                                                           \
+  uint64_t v0 = (key)->k0 ^ 0x736f6d6570736575ULL;                             \
+  uint64_t v1 = (key)->k1 ^ 0x646f72616e646f6dULL;                             \
+  uint64_t v2 = (key)->k0 ^ 0x6c7967656e657261ULL;                             \
+  uint64_t v3 = (key)->k1 ^ 0x7465646279746573ULL
+
+// message words are little endian
+static inline uint64_t load_le(const uint8_t *p, size_t n) {
+  uint64_t w = 0;
+  while (n--)
+    w |= (uint64_t)p[n] << (8 * n);
+  return w;
+}
+
+uint64_t siphash24(const sipKey_t *key, const uint8_t *data, size_t len) {
+  SIPINIT(key);
+  const size_t blocks = len / 8;
+
+  for (size_t i = 0; i < blocks; i++) {
+    const uint64_t m = load_le(data + 8 * i, 8);
+    v3 ^= m;
+    SIPROUND;
+    SIPROUND;
+    v0 ^= m;
+  }
+
+  const uint64_t b =
+      ((uint64_t)len << 56) | load_le(data + 8 * blocks, len & 7);
+  v3 ^= b;
+  SIPROUND;
+  SIPROUND;
+  v0 ^= b;
+
+  v2 ^= 0xff;
+  SIPROUND;
+  SIPROUND;
+  SIPROUND;
+  SIPROUND;
+  return v0 ^ v1 ^ v2 ^ v3;
+}
+
+// same as siphash24(key, paddr, 6), a MAC fits into the final block
+uint64_t siphash24_mac(const sipKey_t *key, const uint8_t *paddr) {
+  SIPINIT(key);
+  const uint64_t b = (6ULL << 56) | ((uint64_t)paddr[5] << 40) |
+                     ((uint64_t)paddr[4] << 32) | ((uint64_t)paddr[3] << 24) |
+                     ((uint64_t)paddr[2] << 16) | ((uint64_t)paddr[1] << 8) |
+                     paddr[0];
+  v3 ^= b;
+  SIPROUND;
+  SIPROUND;
+  v0 ^= b;
+
+  v2 ^= 0xff;
+  SIPROUND;
+  SIPROUND;
+  SIPROUND;
+  SIPROUND;
+  return v0 ^ v1 ^ v2 ^ v3;
+}
@@ -0,0 +1,96 @@
+#include "sketchcodec.h"
+#include "hyperloglog.h"
+
+uint16_t sketch_chunk(uint16_t size, bool packed) {
+  if (size <= SKETCH_HEADER_SIZE)
+    return 0;
+  size -= SKETCH_HEADER_SIZE;
+  return packed ? (size / 3) * 4 : size & ~3;
+}
+
+uint32_t sketch_stamp(uint32_t now, uint32_t period) {
+  if (!period || (now < period))
+    return 0;
+  const uint32_t mid = now - period / 2;
+  return mid - mid % period;
+}
+
+uint16_t sketch_encode(uint8_t *out, const sketchHeader_t *h,
+                       const uint8_t *regs) {
+  uint8_t *p = out;
+  *p++ = h->stamp >> 24;
+  *p++ = (h->stamp >> 16) & 0xFF;
+  *p++ = (h->stamp >> 8) & 0xFF;
+  *p++ = h->stamp & 0xFF;
+  *p++ = (h->precision & SKETCH_PRECISION_MASK) |
+         (h->packed ? SKETCH_PACKED : 0);
+  *p++ = h->first >> 8;
+  *p++ = h->first & 0xFF;
+
+  regs += h->first;
+  if (!h->packed) {
+    for (uint16_t i = 0; i < h->count; i++)
+      *p++ = regs[i];
+    return p - out;
+  }
+
+  // 4 registers of 6 bits in 3 bytes, a short last group is zero padded
+  for (uint16_t i = 0; i < h->count; i += 4) {
+    uint32_t v = 0;
+    for (uint8_t j = 0; j < 4; j++)
+      v = (v << 6) | ((i + j < h->count) ? (regs[i + j] & 0x3F) : 0);
+    *p++ = v >> 16;
+    *p++ = (v >> 8) & 0xFF;
+    *p++ = v & 0xFF;
+  }
+  return p - out;
+}
+
+bool sketch_header(const uint8_t *in, uint16_t len, sketchHeader_t *h) {
+  if (len <= SKETCH_HEADER_SIZE)
+    return false;
+  h->stamp = ((uint32_t)in[0] << 24) | ((uint32_t)in[1] << 16) |
+             ((uint32_t)in[2] << 8) | in[3];
+  h->precision = in[4] & SKETCH_PRECISION_MASK;
+  h->packed = in[4] & SKETCH_PACKED;
+  h->first = (in[5] << 8) | in[6];
+  len -= SKETCH_HEADER_SIZE;
+  if (h->packed && (len % 3))
+    return false;
+  h->count = h->packed ? len / 3 * 4 : len;
+
+  // registers beyond the sketch are padding of a short last group
+  const uint32_t m = 1UL << h->precision;
+  if ((h->precision < HLL_MIN_PRECISION) ||
+      (h->precision > HLL_MAX_PRECISION) || (h->first >= m))
+    return false;
+  if (h->first + h->count > m)
+    h->count = m - h->first;
+  return true;
+}
+
+bool sketch_merge(const uint8_t *in, uint16_t len, uint8_t *regs,
+                  uint8_t precision) {
+  sketchHeader_t h;
+  if (!sketch_header(in, len, &h) || (h.precision != precision))
+    return false;
+
+  in += SKETCH_HEADER_SIZE;
+  regs += h.first;
+  if (!h.packed) {
+    for (uint16_t i = 0; i < h.count; i++)
+      if (in[i] > regs[i])
+        regs[i] = in[i];
+    return true;
+  }
+
+  for (uint16_t i = 0; i < h.count; i += 4, in += 3) {
+    const uint32_t v = (in[0] << 16) | (in[1] << 8) | in[2];
+    for (uint8_t j = 0; (j < 4) && (i + j < h.count); j++) {
+      const uint8_t r = (v >> (18 - 6 * j)) & 0x3F;
+      if (r > regs[i + j])
+        regs[i + j] = r;
+    }
+  }
+  return true;
+}
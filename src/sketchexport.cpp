@@ -0,0 +1,83 @@
+// Basic Config
+#include "sketchexport.h"
+#include "senddata.h"
+#include "timekeeper.h"
+
+#if (SKETCH_EXPORT)
+
+static uint8_t exportRegs[1U << SKETCH_EXPORT_PRECISION],
+    sendRegs[1U << SKETCH_EXPORT_PRECISION];
+static HyperLogLog exportSketch(exportRegs, SKETCH_EXPORT_PRECISION);
+static portMUX_TYPE exportMux = portMUX_INITIALIZER_UNLOCKED;
+static sipKey_t siteKey;
+
+// call at boot and after the site key was changed
+void export_init(void) {
+  uint64_t k[2] = {0, 0};
+  for (uint8_t i = 0; i < 16; i++)
+    k[i / 8] |= (uint64_t)cfg.sitekey[i] << (8 * (i % 8));
+  siteKey.k0 = k[0];
+  siteKey.k1 = k[1];
+  if (!(k[0] | k[1]))
+    ESP_LOGW(TAG, "Sketch export uses default site key, set one by rcommand");
+#if (PAYLOAD_ENCODER >= 3)
+  ESP_LOGW(TAG, "Sketch export not supported by cayenne payload, disabled");
+#endif
+}
+
+// called by the sniffer worker for counted detections
+void export_add(const uint8_t *paddr) {
+  const uint64_t hash = siphash24_mac(&siteKey, paddr);
+  portENTER_CRITICAL(&exportMux);
+  exportSketch.add(hash);
+  portEXIT_CRITICAL(&exportMux);
+}
+
+#if (PAYLOAD_ENCODER < 3)
+// registers fitting in one uplink at current datarate
+static uint16_t export_chunk(void) {
+  uint16_t size = payload.getCapacity();
+#if (HAS_LORA)
+  if (lora_maxpayload() < size)
+    size = lora_maxpayload();
+#endif
+  return sketch_chunk(size, SKETCH_EXPORT_PACKED);
+}
+
+// sketches of all devices of a site sending the same cycle share the stamp,
+// without a synced clock there is none
+static uint32_t export_stamp(void) {
+  if (timeSource == _unsynced)
+    return 0;
+  return sketch_stamp(time(NULL), cfg.sendcycle * 2);
+}
+#endif
+
+// called once per send cycle, sends the sketch of the cycle on SKETCHPORT
+// and starts a new one
+void export_send(void) {
+  portENTER_CRITICAL(&exportMux);
+  memcpy(sendRegs, exportRegs, sizeof(sendRegs));
+  exportSketch.clear();
+  portEXIT_CRITICAL(&exportMux);
+
+#if (PAYLOAD_ENCODER < 3)
+  const uint16_t m = sizeof(sendRegs), chunk = export_chunk();
+  sketchHeader_t h = {export_stamp(), SKETCH_EXPORT_PRECISION,
+                      SKETCH_EXPORT_PACKED, 0, 0};
+  for (h.first = 0; chunk && (h.first < m); h.first += chunk) {
+    h.count = (m - h.first < chunk) ? m - h.first : chunk;
+    payload.reset();
+    payload.addSketch(&h, sendRegs);
+    SendPayload(SKETCHPORT);
+  }
+#endif
+}
+
+#else
+
+void export_init(void) {}
+void export_add(const uint8_t *paddr) {}
+void export_send(void) {}
+
+#endif
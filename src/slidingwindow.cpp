@@ -0,0 +1,60 @@
+#include <string.h>
+
+#include "slidingwindow.h"
+
+SlidingWindow::SlidingWindow(uint8_t *slab, uint16_t slots, uint8_t precision,
+                             uint32_t slotlen)
+    : regs(slab), nslot(slots ? slots : 1), p(precision),
+      len(slotlen ? slotlen : 1) {
+  clear();
+}
+
+void SlidingWindow::clear(void) {
+  memset(regs, 0, (size_t)(nslot + 1) << p);
+  head = 0;
+  epoch = 0;
+}
+
+// move head forward to the slot of now, clearing all slots passed by
+void SlidingWindow::advance(uint32_t now) {
+  const uint32_t e = now / len;
+  if (e <= epoch)
+    return;
+
+  uint32_t steps = e - epoch;
+  if (steps > nslot)
+    steps = nslot;
+  while (steps--) {
+    head = (head + 1) % nslot;
+    memset(slot(head), 0, (size_t)1 << p);
+  }
+  epoch = e;
+}
+
+void SlidingWindow::add(uint64_t hash, uint32_t now) {
+  advance(now);
+  HyperLogLog(slot(head), p, true).add(hash);
+}
+
+uint32_t SlidingWindow::count(uint16_t nslots, uint32_t now) {
+  advance(now);
+  if (nslots >= nslot)
+    nslots = nslot - 1;
+
+  HyperLogLog sum(slot(nslot), p); // scratch sketch behind the ring
+  for (uint16_t i = 0; i <= nslots; i++)
+    sum.merge(HyperLogLog(slot((head + nslot - i) % nslot), p, true));
+
+  return sum.estimate();
+}
+
+void SlidingWindow::copy(uint16_t ago, uint32_t now, uint8_t *out) const {
+  const uint32_t e = now / len;
+  // slot of epoch e - ago, head holds epoch, older slots follow backwards
+  if ((ago > e) || (e - ago > epoch) || (epoch - (e - ago) >= nslot)) {
+    memset(out, 0, (size_t)1 << p);
+    return;
+  }
+  const uint16_t back = epoch - (e - ago);
+  memcpy(out, slot((head + nslot - back) % nslot), (size_t)1 << p);
+}
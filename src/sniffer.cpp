@@ -0,0 +1,249 @@
+// Basic Config
+#include "sniffer.h"
+#include "libpax_helpers.h"
+
+// sniffer callbacks of libpax, not exported by libpax_api.h
+extern "C" {
+void wifi_sniffer_packet_handler(void *buff, wifi_promiscuous_pkt_type_t type);
+void gap_callback_handler(esp_gap_ble_cb_event_t event,
+                          esp_ble_gap_cb_param_t *param);
+}
+
+// detections pass from the driver callbacks to the worker task, one ring
+// per driver task, so each ring has a single producer
+static SpscRing<detection_t, SNIFF_RING_SLOTS> wifiRing, bleRing;
+static TaskHandle_t snifferTask = NULL;
+static volatile bool stopping = false; // worker ends after its next drain
+static volatile bool stopped = false;  // worker has ended
+
+static void sniffer_worker(void *pvParameters);
+
+// 802.11 MAC header, we need only the transmitter address
+typedef struct {
+  uint16_t frame_ctrl;
+  uint16_t duration;
+  uint8_t addr1[6]; // receiver
+  uint8_t addr2[6]; // transmitter
+  uint8_t addr3[6]; // BSSID
+  uint16_t seq_ctrl;
+} wifi_mac_hdr_t;
+
+// frame control: protocol version bits 0-1, type bits 2-3, subtype bits 4-7
+static inline uint8_t frame_class_wifi(uint16_t frame_ctrl) {
+  const uint8_t type = (frame_ctrl >> 2) & 0x03;
+  const uint8_t subtype = (frame_ctrl >> 4) & 0x0f;
+  return ((type == 0) && (subtype == 4)) ? FRAME_WIFI_PROBE : FRAME_WIFI_OTHER;
+}
+
+static inline uint8_t frame_class_ble(esp_ble_evt_type_t evt_type) {
+  switch (evt_type) {
+  case ESP_BLE_EVT_CONN_ADV:
+  case ESP_BLE_EVT_CONN_DIR_ADV:
+    return FRAME_BLE_CONN;
+  case ESP_BLE_EVT_SCAN_RSP:
+    return FRAME_BLE_SCANRSP;
+  default:
+    return FRAME_BLE_NONCONN;
+  }
+}
+
+IRAM_ATTR static void sniffer_wifi_cb(void *buff,
+                                      wifi_promiscuous_pkt_type_t type) {
+  const wifi_promiscuous_pkt_t *ppkt = (wifi_promiscuous_pkt_t *)buff;
+  const wifi_mac_hdr_t *hdr = (wifi_mac_hdr_t *)ppkt->payload;
+
+  // libpax does the counting of frames passing our filters
+  // locally administered bit marks a randomized MAC
+  if (sniffer_detect(hdr->addr2, ppkt->rx_ctrl.rssi, ppkt->rx_ctrl.channel,
+                     MAC_SNIFF_WIFI, hdr->addr2[0] & 0x02,
+                     frame_class_wifi(hdr->frame_ctrl)))
+    wifi_sniffer_packet_handler(buff, type);
+}
+
+static void sniffer_ble_cb(esp_gap_ble_cb_event_t event,
+                           esp_ble_gap_cb_param_t *param) {
+  // scan restarts and parameter changes are handled by us
+  if (bleadapt_event(event, param))
+    return;
+
+  if ((event == ESP_GAP_BLE_SCAN_RESULT_EVT) &&
+      (param->scan_rst.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT) &&
+      !sniffer_detect(param->scan_rst.bda, param->scan_rst.rssi, 0,
+                      MAC_SNIFF_BLE,
+                      param->scan_rst.ble_addr_type != BLE_ADDR_TYPE_PUBLIC,
+                      frame_class_ble(param->scan_rst.ble_evt_type)))
+    return; // filtered, libpax doesn't see it
+
+  gap_callback_handler(event, param);
+}
+
+// must be called after each libpax_counter_start(), because libpax registers
+// its own callbacks when starting the sniffers
+void sniffer_hook_init(void) {
+  stopping = false;
+  if (!snifferTask)
+    xTaskCreatePinnedToCore(sniffer_worker, // task function
+                            "sniffer",      // name of task
+                            3072,           // stack size of task
+                            (void *)1,      // parameter of the task
+                            3,              // priority of the task
+                            &snifferTask,   // task handle
+                            1);             // CPU core, drivers run on 0
+  if (live.wifiscan)
+    esp_wifi_set_promiscuous_rx_cb(&sniffer_wifi_cb);
+  if (live.blescan)
+    esp_ble_gap_register_callback(&sniffer_ble_cb);
+}
+
+// vendor filter by OUI, randomized MACs carry no vendor and always pass
+static inline bool vendor_pass(const uint8_t *paddr, bool random) {
+#if (VENDORFILTER)
+  if (!random) {
+    const uint8_t cls = oui_lookup(oui_from_mac(paddr));
+#if (VENDORFILTER == 2)
+    return cls == OUI_INCLUDE;
+#else
+    return cls != OUI_EXCLUDE;
+#endif
+  }
+#endif
+  return true;
+}
+
+// called in the driver callbacks for every received frame, keep it short.
+// Decides whether libpax sees the frame and hands a record to the worker,
+// returns false if the frame is filtered by vendor, as stationary or below
+// the rssi limit. These filters run here since libpax counts the frames we
+// forward from the callback. The stationary check costs one SipHash and a
+// short critical section, all other hashing is left to the worker.
+IRAM_ATTR bool sniffer_detect(const uint8_t *paddr, int8_t rssi,
+                              uint8_t channel, snifftype_t sniff_type,
+                              bool random, uint8_t frame_class) {
+  if (stopping)
+    return false;
+
+  // infrastructure and IoT devices are no visitors, drop them entirely
+  if (!vendor_pass(paddr, random))
+    return false;
+
+  // so are devices present around the clock
+  if (station_check(paddr))
+    return false;
+
+  // rssi limit is ours, libpax runs without limit
+  const bool counted = !live.rssilimit || (rssi >= live.rssilimit);
+
+  detection_t d;
+  memcpy(d.mac, paddr, sizeof(d.mac));
+  d.time = uptime() / 1000;
+  d.rssi = rssi;
+  d.channel = channel;
+  d.frame_class = frame_class;
+  d.flags = (sniff_type == MAC_SNIFF_WIFI ? 0 : DETECT_BLE) |
+            (random ? DETECT_RANDOM : 0) | (counted ? DETECT_COUNTED : 0);
+
+  // each driver task is the single producer of its own ring
+  SpscRing<detection_t, SNIFF_RING_SLOTS> &ring =
+      (sniff_type == MAC_SNIFF_WIFI) ? wifiRing : bleRing;
+  if (ring.push(d) && (ring.size() == SNIFF_RING_SLOTS / 2) && snifferTask)
+    xTaskNotifyGive(snifferTask); // drain early in a burst
+
+  return counted;
+}
+
+// per device statistics of a detection, runs in the worker task
+static void sniffer_process(const detection_t *d) {
+  const snifftype_t sniff_type =
+      (d->flags & DETECT_BLE) ? MAC_SNIFF_BLE : MAC_SNIFF_WIFI;
+  const bool random = d->flags & DETECT_RANDOM;
+  // tables storing device keys use the rotating salt
+  const uint64_t key = mac_anon(d->mac);
+
+  // track rssi of all devices, so histograms show what the limit cuts off
+  rssi_add(key, d->rssi, random, d->flags & DETECT_COUNTED, d->time);
+
+  if (!(d->flags & DETECT_COUNTED))
+    return;
+
+  // sketches and bloom filters store no keys and use the fixed salt
+  const uint64_t hash = mac_anon_fixed(d->mac);
+  export_add(d->mac);
+
+  if (cfg.countermode == 3)
+    sketch_add(hash, sniff_type);
+
+  if (sniff_type == MAC_SNIFF_WIFI)
+    hop_record(key, d->channel);
+
+  frame_add(hash, d->frame_class);
+  randmac_add(key, random, d->time);
+  window_add(hash, d->time);
+  flow_add(hash);
+  if (recent_add(hash, sniff_type, d->time) &&
+      (sniff_type == MAC_SNIFF_BLE))
+    bleadapt_discovered();
+  dwell_add(key, d->time);
+}
+
+// processes all detections in both rings, by the worker or after it ended.
+// Ring slots are cleared when read and the batch after processing, so a raw
+// MAC stays in memory only until the next drain.
+static void sniffer_drain(void) {
+  static detection_t batch[SNIFF_BATCH];
+  uint32_t n;
+  while ((n = wifiRing.pop(batch, SNIFF_BATCH)))
+    for (uint32_t i = 0; i < n; i++)
+      sniffer_process(batch + i);
+  while ((n = bleRing.pop(batch, SNIFF_BATCH)))
+    for (uint32_t i = 0; i < n; i++)
+      sniffer_process(batch + i);
+  memset(batch, 0, sizeof(batch));
+}
+
+// drains both rings in batches, each SNIFF_DRAIN_MS or when a ring fills up
+static void sniffer_worker(void *pvParameters) {
+  uint32_t dropped = 0;
+
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(SNIFF_DRAIN_MS));
+    // a stop request seen before the drain ends the worker after it
+    const bool stop = stopping;
+    sniffer_drain();
+
+    const uint32_t n = wifiRing.dropped() + bleRing.dropped();
+    if (n != dropped) {
+      ESP_LOGW(TAG, "Sniffer ring overflow, %u detections dropped",
+               n - dropped);
+      dropped = n;
+    }
+    if (stop)
+      break;
+  }
+  snifferTask = NULL;
+  stopped = true;
+  vTaskDelete(NULL);
+}
+
+// call after libpax_counter_stop(), ends the worker and processes what is
+// left in the rings. Afterwards no detection changes the device tables and
+// sketches, until sniffer_hook_init() starts a new worker.
+void sniffer_stop(void) {
+  if (!snifferTask)
+    return;
+  stopped = false;
+  stopping = true;
+  xTaskNotifyGive(snifferTask);
+  while (!stopped)
+    vTaskDelay(pdMS_TO_TICKS(1));
+  // this task is the only consumer now, callbacks still running when the
+  // worker ended may have pushed a few more
+  sniffer_drain();
+}
+
+// detections handed to the worker and dropped for a full ring, per sniffer
+void sniffer_stats(uint32_t pushed[2], uint32_t dropped[2]) {
+  pushed[MAC_SNIFF_WIFI] = wifiRing.pushed();
+  pushed[MAC_SNIFF_BLE] = bleRing.pushed();
+  dropped[MAC_SNIFF_WIFI] = wifiRing.dropped();
+  dropped[MAC_SNIFF_BLE] = bleRing.dropped();
+}
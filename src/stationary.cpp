@@ -0,0 +1,91 @@
+// Basic Config
+#include "stationary.h"
+#include "reset.h"
+
+#if (STATIONARY_FILTER)
+
+#define STATION_MAGIC 0x53544e31
+
+typedef struct {
+  uint32_t magic; // STATION_MAGIC if table is valid
+  uint32_t sets;  // table geometry of the firmware which wrote it
+  sipKey_t key;
+  presenceEntry_t entry[STATIONARY_SETS * PRESENCE_WAYS];
+} stationState_t;
+
+RTC_NOINIT_ATTR static stationState_t stationState;
+static PresenceTable station(stationState.entry, STATIONARY_SETS,
+                             STATIONARY_THRESHOLD, STATIONARY_GAP);
+static portMUX_TYPE stationMux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t stationAged = 0;        // uptime [seconds] of last age()
+static volatile uint32_t stationFrames; // frames excluded since boot
+static uint32_t stationExcluded = 0;    // devices excluded at last update
+
+void station_init(void) {
+  stationAged = uptime() / 1000;
+  if ((stationState.magic == STATION_MAGIC) &&
+      (stationState.sets == STATIONARY_SETS)) {
+    ESP_LOGI(TAG, "Stationary devices table kept, %u of %u excluded",
+             station.excluded(), station.size());
+    return;
+  }
+  stationState.key.k0 = ((uint64_t)esp_random() << 32) | esp_random();
+  stationState.key.k1 = ((uint64_t)esp_random() << 32) | esp_random();
+  station.clear();
+  stationState.sets = STATIONARY_SETS;
+  stationState.magic = STATION_MAGIC;
+}
+
+// called at cold start, table and salt start over
+void station_invalidate(void) { stationState.magic = 0; }
+
+// called in the sniffer callbacks, true if device is stationary
+bool station_check(const uint8_t *paddr) {
+  const uint32_t tag = (uint32_t)siphash24_mac(&stationState.key, paddr);
+  portENTER_CRITICAL(&stationMux);
+  const bool excluded = station.seen(tag);
+  portEXIT_CRITICAL(&stationMux);
+  if (excluded)
+    stationFrames++;
+  return excluded;
+}
+
+// called by housekeeping, ages the table in whole minutes
+void station_update(void) {
+  const uint32_t minutes = (uptime() / 1000 - stationAged) / 60;
+  if (!minutes)
+    return;
+  stationAged += minutes * 60;
+
+  portENTER_CRITICAL(&stationMux);
+  station.age(minutes > UINT16_MAX ? UINT16_MAX : minutes);
+  const uint32_t excluded = station.excluded();
+  portEXIT_CRITICAL(&stationMux);
+
+  if (excluded != stationExcluded)
+    ESP_LOGI(TAG, "Stationary devices excluded: %u (was %u)", excluded,
+             stationExcluded);
+  stationExcluded = excluded;
+}
+
+void station_stats(uint16_t *tracked, uint16_t *excluded, uint32_t *frames) {
+  portENTER_CRITICAL(&stationMux);
+  const uint32_t t = station.size(), e = station.excluded();
+  portEXIT_CRITICAL(&stationMux);
+  *tracked = (t > UINT16_MAX) ? UINT16_MAX : t;
+  *excluded = (e > UINT16_MAX) ? UINT16_MAX : e;
+  *frames = stationFrames;
+}
+
+#else
+
+void station_init(void) {}
+void station_invalidate(void) {}
+bool station_check(const uint8_t *paddr) { return false; }
+void station_update(void) {}
+void station_stats(uint16_t *tracked, uint16_t *excluded, uint32_t *frames) {
+  *tracked = *excluded = 0;
+  *frames = 0;
+}
+
+#endif
@@ -8,9 +8,12 @@
 #define WIFI_MAX_TRY 10 // Define maximum attempts to connect to WiFi
 
 // Array to store detected devices
-DeviceInfo detectedDevices[100]; // Adjust size as needed
+DeviceInfo detectedDevices[WIFI_SCAN_MAX_DEVICES];
 int deviceCount = 0;
 
+// hash set for duplicate detection, twice the slots keeps probe chains short
+static StaticMacDedup<2 * WIFI_SCAN_MAX_DEVICES> scanDedup;
+
 bool connectWifi() {
     stopWifiScan();
     WiFi.disconnect(true);
@@ -54,44 +57,86 @@ bool connectWifi() {
 
 void disconnectWifi() {}
 
-void stopWifiScan() {
-    uint8_t val[] = {0};
-    set_wifiscan(val);
+// scan backend on top of the WiFi library, scans run asynchronously
+static bool scanStart(void) {
+    return WiFi.scanNetworks(true) == WIFI_SCAN_RUNNING;
 }
 
+static int16_t scanStatus(void) { return WiFi.scanComplete(); }
+
+static bool scanResult(int16_t i, DeviceInfo *info) {
+    const uint8_t *bssid = WiFi.BSSID(i);
+    if (!bssid)
+        return false;
+    info->mac = mac_to_u64(bssid);
+    info->rssi = WiFi.RSSI(i);
+    info->channel = WiFi.channel(i);
+    return true;
+}
+
+static void scanRelease(void) { WiFi.scanDelete(); }
+
+static const WifiScanBackend scanBackend = {scanStart, scanStatus, scanResult,
+                                            scanRelease};
+static WifiScan wifiScan(&scanBackend, detectedDevices, WIFI_SCAN_MAX_DEVICES);
+
+static void scanDone(const DeviceInfo *devices, uint16_t count,
+                     uint16_t dropped) {
+    deviceCount = count;
+    if (dropped)
+        ESP_LOGW(TAG, "Scan result buffer full, %u devices dropped", dropped);
+    ESP_LOGI(TAG, "WiFi scan done, %u devices, %u unique", count,
+             analyzeDetectedDevices());
+}
+
+// runs in WiFi event task when the scan has finished
+static void scanEvent(arduino_event_id_t event, arduino_event_info_t info) {
+    wifiScan.poll();
+}
+
+// starts one scan and returns immediately, results are collected by scanDone()
 void startWifiScan() {
+    static bool eventRegistered = false;
+
     uint8_t val[] = {1};
     set_wifiscan(val);
-    
-    // Clear previous device data
-    deviceCount = 0;
-
-    // Start scanning and collect device information
-    // This is a placeholder for the actual scanning logic
-    // In a real implementation, you would use WiFi.scanNetworks() and collect MAC and RSSI
-    for (int i = 0; i < WiFi.scanNetworks(); i++) {
-        String macAddress = WiFi.BSSIDstr(i); // Get MAC address
-        int rssi = WiFi.RSSI(i); // Get RSSI
-        detectedDevices[deviceCount++] = {macAddress, rssi}; // Store device info
+
+    if (!eventRegistered) {
+        wifiScan.onComplete(scanDone);
+        WiFi.onEvent(scanEvent, ARDUINO_EVENT_WIFI_SCAN_DONE);
+        eventRegistered = true;
     }
 
-    // Implement logic to analyze detectedDevices for duplicates based on RSSI and MAC
+    if (!wifiScan.trigger())
+        ESP_LOGW(TAG, "WiFi scan %s", wifiScan.state() == WifiScan::RUNNING
+                                           ? "already running"
+                                           : "could not be started");
+}
+
+void stopWifiScan() {
+    uint8_t val[] = {0};
+    set_wifiscan(val);
+    wifiScan.reset();
 }
 
-void analyzeDetectedDevices() {
+uint16_t analyzeDetectedDevices() {
+    scanDedup.clear();
+
     for (int i = 0; i < deviceCount; i++) {
-        for (int j = i + 1; j < deviceCount; j++) {
-            // Check if MAC addresses are the same
-            if (detectedDevices[i].macAddress == detectedDevices[j].macAddress) {
-                // Handle duplicate device logic, e.g., log or ignore
-                ESP_LOGI(TAG, "Duplicate device detected: %s with RSSI %d and %d", 
-                         detectedDevices[i].macAddress.c_str(), 
-                         detectedDevices[i].rssi, 
-                         detectedDevices[j].rssi);
-            }
-            // Additional logic can be added to handle RSSI thresholds for duplicates
+        // hash set lookup replaces pairwise compare of all scan results
+        if (!scanDedup.insert(detectedDevices[i].mac) &&
+            scanDedup.contains(detectedDevices[i].mac)) {
+            // Handle duplicate device logic, e.g., log or ignore
+            ESP_LOGI(TAG, "Duplicate device detected: %012llX with RSSI %d",
+                     detectedDevices[i].mac, detectedDevices[i].rssi);
         }
     }
+
+    if (scanDedup.dropped())
+        ESP_LOGW(TAG, "Dedup table full, %u devices not analyzed",
+                 scanDedup.dropped());
+
+    return scanDedup.size();
 }
 WiFiUDP ntpUDP;
 NTPClient timeClient(ntpUDP, "pool.ntp.org", 0, 60000); // NTP server and update interval
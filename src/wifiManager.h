@@ -4,20 +4,20 @@
 #include <rcommand.h> // must be included here so that Arduino library object file references work
 #include "globals.h"
 #include "timekeeper.h"
+#include "macdedup.h"
+#include "wifiscan.h"
 
-// Define the DeviceInfo structure
-struct DeviceInfo {
-    String macAddress;
-    int rssi;
-};
+#ifndef WIFI_SCAN_MAX_DEVICES
+#define WIFI_SCAN_MAX_DEVICES 512 // maximum number of devices kept per scan
+#endif
 
 // Declare the extern variables
 extern DeviceInfo detectedDevices[]; // Expose detectedDevices array
-extern int deviceCount; // Expose deviceCount variable
+extern int deviceCount; // Expose deviceCount variable, set when a scan completes
 
 bool connectWifi();
-void analyzeDetectedDevices(); // Declare the function for testing
-void startWifiScan();
+uint16_t analyzeDetectedDevices(); // returns number of unique devices
+void startWifiScan(); // non blocking, one scan per call
 void stopWifiScan();
 
 #endif // _WIFIMANAGER_H
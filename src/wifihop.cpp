@@ -0,0 +1,111 @@
+// Basic Config
+#include "wifihop.h"
+#include "liveconfig.h"
+
+#include <esp_wifi.h>
+#include <esp_timer.h>
+
+// channel hopping replaces the fixed round robin of libpax, so channel
+// settings can change at a hop boundary without a libpax restart. libpax is
+// configured not to hop, a timer switches channels. With HOP_ADAPTIVE dwell
+// times are reweighted by the per channel activity, otherwise all channels
+// get the same dwell time.
+static ChanHop hop(0, 0, HOP_MIN_DWELL, HOP_MAX_DWELL,
+                   HOP_ADAPTIVE ? HOP_EXPLORE : 100);
+static portMUX_TYPE hopMux = portMUX_INITIALIZER_UNLOCKED;
+static esp_timer_handle_t hopTimer = NULL;
+static volatile bool hopping = false; // hop timer is armed
+
+// devices seen during the current round, to count new devices per channel
+static StaticMacDedup<HOP_DEDUP_SLOTS> hopSeen;
+
+static bool hop_enabled(void) {
+  return live.wifiscan && live.wifichancycle &&
+         (live.wifichanmap & (live.wifichanmap - 1)); // more than one channel
+}
+
+static void hop_switch(void *arg) {
+  // pending configuration changes take effect at the hop boundary
+  if (live_pending())
+    live_apply();
+
+  if (!hop_enabled()) {
+    hopping = false;
+    return;
+  }
+
+  uint16_t dwell = 0;
+  portENTER_CRITICAL(&hopMux);
+  const uint8_t previous = hop.channel();
+  const uint8_t channel = hop.next(&dwell);
+  if (channel <= previous) // new round
+    hopSeen.clear();
+  portEXIT_CRITICAL(&hopMux);
+
+  if (!channel) {
+    hopping = false;
+    return;
+  }
+  esp_wifi_set_channel(channel, WIFI_SECOND_CHAN_NONE);
+  esp_timer_start_once(hopTimer, (uint64_t)dwell * 1000);
+}
+
+// true while channel hopping runs, live changes then wait for next hop
+bool hop_active(void) { return hopping; }
+
+// (re)loads channel settings from live config
+void hop_setup(void) {
+  portENTER_CRITICAL(&hopMux);
+  hop.setup(live.wifichanmap, live.wifichancycle * 10);
+  hopSeen.clear();
+  portEXIT_CRITICAL(&hopMux);
+
+  if (hop_enabled()) {
+    if (!hopping) {
+      ESP_LOGI(TAG, "%s channel hopping on, channel map 0x%04X",
+               HOP_ADAPTIVE ? "Adaptive" : "Fixed", live.wifichanmap);
+      hopping = true;
+      esp_timer_start_once(hopTimer, 1000); // hop from timer task
+    }
+  } else if (live.wifiscan) {
+    // hopping off, stay on channel 1 or the only channel of the map
+    uint8_t channel = 1;
+    if (live.wifichancycle && live.wifichanmap)
+      channel = __builtin_ctz(live.wifichanmap) + 1;
+    esp_wifi_set_channel(channel, WIFI_SECOND_CHAN_NONE);
+  }
+}
+
+// call after libpax_counter_start()
+void hop_start(void) {
+  if (!hopTimer) {
+    const esp_timer_create_args_t args = {
+        .callback = &hop_switch, .arg = NULL, .name = "hoptimer"};
+    esp_timer_create(&args, &hopTimer);
+  }
+  esp_timer_stop(hopTimer);
+  hopping = false;
+  hop_setup();
+}
+
+void hop_record(uint64_t key, uint8_t channel) {
+  if (!hop_enabled())
+    return;
+  portENTER_CRITICAL(&hopMux);
+  hop.record(channel, hopSeen.insert(key));
+  portEXIT_CRITICAL(&hopMux);
+}
+
+// copies statistics of enabled channels in ascending order and resets their
+// counters, returns channel map
+uint16_t hop_stats(ChanHopStats stats[CHANHOP_CHANNELS]) {
+  uint8_t n = 0;
+  portENTER_CRITICAL(&hopMux);
+  const uint16_t map = hop.channels();
+  for (uint8_t c = 1; c <= CHANHOP_CHANNELS; c++)
+    if (map & (1 << (c - 1)))
+      stats[n++] = *hop.stats(c);
+  hop.resetStats();
+  portEXIT_CRITICAL(&hopMux);
+  return map;
+}
@@ -0,0 +1,63 @@
+#include "wifiscan.h"
+
+WifiScan::WifiScan(const WifiScanBackend *backend, DeviceInfo *buffer,
+                   uint16_t capacity)
+    : be(backend), buf(buffer), cap(capacity), n(0), lost(0), st(IDLE),
+      callback(NULL) {}
+
+bool WifiScan::trigger(void) {
+  std::lock_guard<std::mutex> guard(lock);
+  if (st != IDLE)
+    return false; // one scan at a time, results of running scan will follow
+
+  n = 0;
+  lost = 0;
+  // running before start, the scan may complete before start returns
+  st = RUNNING;
+  if (!be->start()) {
+    st = IDLE;
+    return false;
+  }
+  return true;
+}
+
+bool WifiScan::poll(void) {
+  uint16_t count, dropped;
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    if (st != RUNNING)
+      return false;
+
+    const int16_t status = be->status();
+    if (status == WIFISCAN_RUNNING)
+      return false;
+
+    if (status > 0) {
+      for (int16_t i = 0; i < status; i++) {
+        if (n >= cap) {
+          lost = status - i;
+          break;
+        }
+        if (be->result(i, buf + n))
+          n++;
+      }
+    }
+    be->release();
+    st = IDLE;
+    count = n;
+    dropped = lost;
+  }
+  // unlocked, so the callback may trigger the next scan
+  if (callback)
+    callback(buf, count, dropped);
+  return true;
+}
+
+void WifiScan::reset(void) {
+  std::lock_guard<std::mutex> guard(lock);
+  if (st == RUNNING)
+    be->release();
+  st = IDLE;
+  n = 0;
+  lost = 0;
+}
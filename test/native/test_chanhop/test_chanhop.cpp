@@ -0,0 +1,100 @@
+// host tests for adaptive WiFi channel hopping, simulating traffic with a
+// fixed number of frames per second on each channel
+// run with: pio test -e native -f native/test_chanhop -v
+
+#include <unity.h>
+
+#include "chanhop.h"
+
+// frames per second on channels 1..13, busy 1/6/11 as in most sites
+static const uint32_t busy[CHANHOP_CHANNELS + 1] = {0, 40, 1, 1, 1, 1, 60,
+                                                    1, 0, 0, 1, 50, 0, 0};
+static const uint32_t flat[CHANHOP_CHANNELS + 1] = {0, 10, 10, 10, 10, 10, 10,
+                                                    10, 10, 10, 10, 10, 10, 10};
+
+// hops rounds x 13 channels, returns frames captured, every 4th is new
+static uint32_t simulate(ChanHop &hop, const uint32_t *traffic,
+                         uint32_t rounds) {
+  uint32_t captured = 0;
+  uint16_t dwell;
+  for (uint32_t i = 0; i < rounds * CHANHOP_CHANNELS; i++) {
+    const uint8_t c = hop.next(&dwell);
+    const uint32_t frames = traffic[c] * dwell / 1000;
+    for (uint32_t f = 0; f < frames; f++)
+      hop.record(c, !(f % 4));
+    captured += frames;
+  }
+  return captured;
+}
+
+static uint32_t round_length(const ChanHop &hop) {
+  uint32_t sum = 0;
+  for (uint8_t c = 1; c <= CHANHOP_CHANNELS; c++)
+    sum += hop.stats(c)->dwell;
+  return sum;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_flat_traffic_keeps_dwell(void) {
+  ChanHop hop(0x1FFF, 500, 50, 2000, 30);
+  simulate(hop, flat, 50);
+  for (uint8_t c = 1; c <= CHANHOP_CHANNELS; c++)
+    TEST_ASSERT_UINT32_WITHIN(5, 500, hop.stats(c)->dwell);
+}
+
+void test_busy_channels_get_more_time(void) {
+  ChanHop hop(0x1FFF, 500, 50, 2000, 30);
+  simulate(hop, busy, 50);
+  // explore share keeps quiet channels sampled, 30% of 500ms
+  TEST_ASSERT_TRUE(hop.stats(9)->dwell >= 150);
+  TEST_ASSERT_TRUE(hop.stats(6)->dwell > hop.stats(1)->dwell);
+  TEST_ASSERT_TRUE(hop.stats(1)->dwell > 4 * hop.stats(2)->dwell);
+  for (uint8_t c = 1; c <= CHANHOP_CHANNELS; c++) {
+    TEST_ASSERT_TRUE(hop.stats(c)->dwell >= 50);
+    TEST_ASSERT_TRUE(hop.stats(c)->dwell <= 2000);
+  }
+  // duty cycle is unchanged, rounding may lose a few ms
+  TEST_ASSERT_UINT32_WITHIN(CHANHOP_CHANNELS, 13 * 500, round_length(hop));
+}
+
+void test_dwell_limits(void) {
+  ChanHop hop(0x1FFF, 500, 200, 1000, 0);
+  simulate(hop, busy, 50);
+  for (uint8_t c = 1; c <= CHANHOP_CHANNELS; c++) {
+    TEST_ASSERT_TRUE(hop.stats(c)->dwell >= 200);
+    TEST_ASSERT_TRUE(hop.stats(c)->dwell <= 1000);
+  }
+}
+
+void test_captures_more_than_round_robin(void) {
+  // explore 100% spreads all time evenly, as fixed round robin does
+  ChanHop fixed(0x1FFF, 500, 50, 2000, 100);
+  ChanHop adaptive(0x1FFF, 500, 50, 2000, 30);
+  const uint32_t f = simulate(fixed, busy, 200);
+  const uint32_t a = simulate(adaptive, busy, 200);
+  TEST_ASSERT_EQUAL_UINT32(13 * 500, round_length(fixed));
+  TEST_ASSERT_TRUE(a >= 3 * f);
+}
+
+void test_disabled_channels_skipped(void) {
+  ChanHop hop((1 << 0) | (1 << 5) | (1 << 10), 500, 50, 2000, 30);
+  uint16_t dwell;
+  TEST_ASSERT_EQUAL_UINT8(1, hop.next(&dwell));
+  TEST_ASSERT_EQUAL_UINT8(6, hop.next(&dwell));
+  TEST_ASSERT_EQUAL_UINT8(11, hop.next(&dwell));
+  TEST_ASSERT_EQUAL_UINT8(1, hop.next(&dwell));
+  hop.setup(0, 500);
+  TEST_ASSERT_EQUAL_UINT8(0, hop.next(&dwell));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_flat_traffic_keeps_dwell);
+  RUN_TEST(test_busy_channels_get_more_time);
+  RUN_TEST(test_dwell_limits);
+  RUN_TEST(test_captures_more_than_round_robin);
+  RUN_TEST(test_disabled_channels_skipped);
+  return UNITY_END();
+}
@@ -0,0 +1,72 @@
+// host tests for arrival and departure counting
+// run with: pio test -e native -f native/test_flowbloom -v
+
+#include <unity.h>
+
+#include "flowbloom.h"
+
+static StaticFlowBloom<16384> flow;
+
+// splitmix64, well mixed keys like the anonymized MACs
+static uint64_t key(uint64_t i) {
+  uint64_t z = i + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// one interval seeing devices first .. last - 1, each a few times
+static void interval(uint32_t first, uint32_t last) {
+  for (uint8_t r = 0; r < 3; r++)
+    for (uint32_t i = first; i < last; i++)
+      flow.add(key(i));
+}
+
+void setUp(void) { flow.clear(); }
+void tearDown(void) {}
+
+void test_first_interval_all_arrive(void) {
+  uint32_t arrivals, departures;
+  interval(0, 100);
+  TEST_ASSERT_EQUAL_UINT32(100, flow.devices());
+  flow.rotate(&arrivals, &departures);
+  TEST_ASSERT_EQUAL_UINT32(100, arrivals);
+  TEST_ASSERT_EQUAL_UINT32(0, departures);
+}
+
+void test_turnover(void) {
+  uint32_t arrivals, departures;
+  interval(0, 1000);
+  flow.rotate(&arrivals, &departures);
+  // 300 leave, 200 arrive, about 1% false positives
+  interval(300, 1200);
+  flow.rotate(&arrivals, &departures);
+  TEST_ASSERT_UINT32_WITHIN(10, 200, arrivals);
+  TEST_ASSERT_UINT32_WITHIN(10, 300, departures);
+  // all leave
+  flow.rotate(&arrivals, &departures);
+  TEST_ASSERT_EQUAL_UINT32(0, arrivals);
+  TEST_ASSERT_UINT32_WITHIN(10, 900, departures);
+}
+
+void test_net_flow_matches_occupancy(void) {
+  // a crowd growing by 20 and moving on by 50 devices per interval
+  uint32_t arrivals, departures, devices = 0;
+  int32_t occupancy = 0;
+  for (uint32_t c = 0; c < 10; c++) {
+    interval(c * 50, c * 50 + 500 + c * 20);
+    devices = flow.devices();
+    flow.rotate(&arrivals, &departures);
+    occupancy += (int32_t)arrivals - (int32_t)departures;
+  }
+  TEST_ASSERT_UINT32_WITHIN(10, 680, devices);
+  TEST_ASSERT_INT32_WITHIN(20, (int32_t)devices, occupancy);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_interval_all_arrive);
+  RUN_TEST(test_turnover);
+  RUN_TEST(test_net_flow_matches_occupancy);
+  return UNITY_END();
+}
@@ -0,0 +1,69 @@
+// host tests for the generational bloom filter
+// run with: pio test -e native -f native/test_genbloom -v
+
+#include <unity.h>
+
+#include "genbloom.h"
+
+// 4 generations of 10 seconds
+static StaticGenBloom<8192> recent(4, 40);
+
+// splitmix64, well mixed keys like the anonymized MACs
+static uint64_t key(uint64_t i) {
+  uint64_t z = i + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// devices first .. last - 1 seen at second now, returns number of new ones
+static uint32_t seen(uint32_t first, uint32_t last, uint32_t now) {
+  uint32_t n = 0;
+  for (uint32_t i = first; i < last; i++)
+    n += recent.add(key(i), now);
+  return n;
+}
+
+void setUp(void) { recent.clear(); }
+void tearDown(void) {}
+
+void test_generations_fade_out(void) {
+  for (uint32_t g = 0; g < 4; g++)
+    TEST_ASSERT_UINT32_WITHIN(2, 100, seen(g * 100, g * 100 + 100, g * 10));
+  TEST_ASSERT_UINT32_WITHIN(4, 400, recent.count(39));
+  TEST_ASSERT_UINT32_WITHIN(3, 300, recent.count(40));
+  TEST_ASSERT_UINT32_WITHIN(2, 100, recent.count(60));
+  TEST_ASSERT_EQUAL_UINT32(0, recent.count(70));
+}
+
+void test_seen_again_moves_forward(void) {
+  seen(0, 200, 0);
+  TEST_ASSERT_EQUAL_UINT32(0, seen(0, 200, 5));
+  TEST_ASSERT_UINT32_WITHIN(2, 0, seen(0, 200, 30));
+  TEST_ASSERT_UINT32_WITHIN(2, 200, recent.count(60));
+  TEST_ASSERT_EQUAL_UINT32(0, recent.count(70));
+}
+
+void test_stamps_do_not_wrap_to_fresh(void) {
+  // stepping through all stamps leaves no cell looking fresh
+  seen(0, 500, 0);
+  for (uint32_t t = 10; t <= GENBLOOM_STAMPS * 10; t += 10)
+    recent.count(t);
+  TEST_ASSERT_EQUAL_UINT32(0, recent.count(GENBLOOM_STAMPS * 10));
+  TEST_ASSERT_UINT32_WITHIN(2, 500, seen(0, 500, GENBLOOM_STAMPS * 10));
+}
+
+void test_long_gap_expires_all(void) {
+  seen(0, 500, 0);
+  TEST_ASSERT_EQUAL_UINT32(0, recent.count(GENBLOOM_STAMPS * 10));
+  TEST_ASSERT_UINT32_WITHIN(2, 500, seen(0, 500, GENBLOOM_STAMPS * 10));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_generations_fade_out);
+  RUN_TEST(test_seen_again_moves_forward);
+  RUN_TEST(test_stamps_do_not_wrap_to_fresh);
+  RUN_TEST(test_long_gap_expires_all);
+  return UNITY_END();
+}
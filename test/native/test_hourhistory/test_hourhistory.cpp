@@ -0,0 +1,90 @@
+// host tests for the hourly count history
+// run with: pio test -e native -f native/test_hourhistory -v
+
+#include <unity.h>
+
+#include "hourhistory.h"
+
+#define HOURS 168
+
+static StaticHourHistory<HOURS> history;
+
+static void sample(uint32_t hour, uint16_t pax) {
+  const uint16_t v[HISTORY_SERIES] = {pax, (uint16_t)(pax - pax / 4),
+                                      (uint16_t)(pax / 4)};
+  history.add(hour, v);
+}
+
+void setUp(void) { history.clear(); }
+void tearDown(void) {}
+
+void test_aggregates_of_an_hour(void) {
+  histRecord_t r;
+  sample(1000, 10);
+  sample(1000, 40);
+  sample(1000, 20);
+  TEST_ASSERT_EQUAL_UINT16(1, history.held());
+  TEST_ASSERT_TRUE(history.get(0, &r));
+  TEST_ASSERT_EQUAL_UINT16(10, r.min[0]);
+  TEST_ASSERT_EQUAL_UINT16(40, r.max[0]);
+  TEST_ASSERT_EQUAL_UINT16(23, r.mean[0]);
+  TEST_ASSERT_EQUAL_UINT16(10, r.max[2]);
+  TEST_ASSERT_FALSE(history.get(1, &r));
+}
+
+void test_skipped_hours_are_empty(void) {
+  histRecord_t r;
+  sample(1000, 10);
+  sample(1003, 30);
+  TEST_ASSERT_EQUAL_UINT16(4, history.held());
+  TEST_ASSERT_TRUE(history.get(0, &r));
+  TEST_ASSERT_EQUAL_UINT16(30, r.mean[0]);
+  TEST_ASSERT_TRUE(history.get(1, &r));
+  TEST_ASSERT_TRUE(r.min[0] > r.max[0]);
+  TEST_ASSERT_TRUE(history.get(3, &r));
+  TEST_ASSERT_EQUAL_UINT16(10, r.mean[0]);
+}
+
+void test_clock_jump_starts_new_hour(void) {
+  histRecord_t r;
+  sample(5, 10);      // uptime hours before time sync
+  sample(480000, 20); // unix hours after time sync
+  TEST_ASSERT_EQUAL_UINT16(2, history.held());
+  TEST_ASSERT_TRUE(history.get(1, &r));
+  TEST_ASSERT_EQUAL_UINT16(10, r.mean[0]);
+}
+
+void test_ring_keeps_last_week(void) {
+  histRecord_t r;
+  for (uint32_t h = 0; h < 2 * HOURS; h++)
+    sample(h, h);
+  TEST_ASSERT_EQUAL_UINT16(HOURS, history.held());
+  TEST_ASSERT_TRUE(history.get(HOURS - 1, &r));
+  TEST_ASSERT_EQUAL_UINT16(HOURS, r.mean[0]);
+  TEST_ASSERT_FALSE(history.get(HOURS, &r));
+}
+
+void test_records_clamped_to_buffer(void) {
+  // 18 byte records behind the age byte in a 64 byte buffer
+  TEST_ASSERT_EQUAL_UINT8(3, history_records(64, 222, 18));
+  TEST_ASSERT_EQUAL_UINT8(3, history_records(64, UINT16_MAX, 18));
+  TEST_ASSERT_EQUAL_UINT8(2, history_records(64, 51, 18));
+  TEST_ASSERT_EQUAL_UINT8(14, history_records(255, 255, 18));
+  // small uplink still gets one record, a small buffer none
+  TEST_ASSERT_EQUAL_UINT8(1, history_records(64, 11, 18));
+  TEST_ASSERT_EQUAL_UINT8(1, history_records(19, 0, 18));
+  TEST_ASSERT_EQUAL_UINT8(0, history_records(18, 222, 18));
+  for (uint16_t cap = 0; cap <= 255; cap++)
+    TEST_ASSERT_TRUE(1 + 18 * history_records(cap, 222, 18) <= cap ||
+                     !history_records(cap, 222, 18));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_aggregates_of_an_hour);
+  RUN_TEST(test_skipped_hours_are_empty);
+  RUN_TEST(test_clock_jump_starts_new_hour);
+  RUN_TEST(test_ring_keeps_last_week);
+  RUN_TEST(test_records_clamped_to_buffer);
+  return UNITY_END();
+}
@@ -0,0 +1,88 @@
+// host tests and scaling benchmark for the MAC dedup hash set
+// run with: pio test -e native -f native/test_macdedup -v
+
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+
+#include "macdedup.h"
+
+static StaticMacDedup<16384> table;
+
+// deterministic pseudo random MACs, a few vendor OUIs like in a real scan
+static uint64_t test_mac(uint32_t i) {
+  static const uint64_t oui[] = {0x3C2EFF, 0xF0D1A9, 0xDA0F01, 0x001A11};
+  uint64_t nic = (i * 2654435761u) & 0xFFFFFF;
+  return (oui[i & 3] << 24) | nic;
+}
+
+void setUp(void) { table.clear(); }
+void tearDown(void) {}
+
+void test_mac_to_u64(void) {
+  const uint8_t mac[6] = {0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+  TEST_ASSERT_EQUAL_HEX64(0xAABBCCDDEEFFULL, mac_to_u64(mac));
+}
+
+void test_insert_and_lookup(void) {
+  TEST_ASSERT_TRUE(table.insert(0xAABBCCDDEEFFULL));
+  TEST_ASSERT_FALSE(table.insert(0xAABBCCDDEEFFULL)); // duplicate
+  TEST_ASSERT_TRUE(table.insert(0x112233445566ULL));
+  TEST_ASSERT_TRUE(table.insert(0)); // null MAC is a valid key
+  TEST_ASSERT_TRUE(table.contains(0x112233445566ULL));
+  TEST_ASSERT_FALSE(table.contains(0x665544332211ULL));
+  TEST_ASSERT_EQUAL_UINT32(3, table.size());
+  table.clear();
+  TEST_ASSERT_EQUAL_UINT32(0, table.size());
+  TEST_ASSERT_FALSE(table.contains(0xAABBCCDDEEFFULL));
+}
+
+void test_overflow_is_counted(void) {
+  StaticMacDedup<8> small;
+  TEST_ASSERT_EQUAL_UINT32(6, small.capacity());
+  for (uint32_t i = 0; i < 10; i++)
+    small.insert(test_mac(i));
+  TEST_ASSERT_EQUAL_UINT32(6, small.size());
+  TEST_ASSERT_EQUAL_UINT32(4, small.dropped());
+  // table stays usable when full
+  TEST_ASSERT_TRUE(small.contains(test_mac(0)));
+  TEST_ASSERT_FALSE(small.contains(test_mac(9)));
+}
+
+void test_bench_scaling(void) {
+  static const uint32_t sizes[] = {100, 400, 1000, 4000, 10000};
+  char line[96];
+
+  for (uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    const uint32_t n = sizes[s];
+    const uint32_t rounds = 200000 / n + 1;
+    uint32_t unique = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < rounds; r++) {
+      table.clear();
+      // every device is seen twice per scan
+      for (uint32_t i = 0; i < 2 * n; i++)
+        table.insert(test_mac(i % n));
+      unique = table.size();
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    TEST_ASSERT_EQUAL_UINT32(n, unique);
+    TEST_ASSERT_EQUAL_UINT32(0, table.dropped());
+
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count() /
+                ((double)rounds * 2 * n);
+    snprintf(line, sizeof(line), "%5u devices: %6.1f ns/insert", n, ns);
+    TEST_MESSAGE(line);
+  }
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_mac_to_u64);
+  RUN_TEST(test_insert_and_lookup);
+  RUN_TEST(test_overflow_is_counted);
+  RUN_TEST(test_bench_scaling);
+  return UNITY_END();
+}
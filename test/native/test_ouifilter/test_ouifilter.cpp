@@ -0,0 +1,78 @@
+// host tests and lookup rate benchmark for the OUI vendor filter
+// run with: pio test -e native -f native/test_ouifilter -v
+
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+
+#include "ouifilter.h"
+#include "ouitable.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_oui_from_mac(void) {
+  const uint8_t mac[6] = {0x24, 0x0A, 0xC4, 0x11, 0x22, 0x33};
+  TEST_ASSERT_EQUAL_HEX32(0x240AC4, oui_from_mac(mac));
+}
+
+void test_table_entries_are_found(void) {
+  uint32_t found = 0;
+  for (uint32_t i = 0; i < (1u << OUI_TABLE_BITS); i++) {
+    if (!oui_table[i])
+      continue;
+    TEST_ASSERT_EQUAL_UINT8(oui_table[i] >> 24,
+                            oui_lookup(oui_table[i] & 0xFFFFFF));
+    found++;
+  }
+  TEST_ASSERT_EQUAL_UINT32(OUI_ENTRIES, found);
+}
+
+void test_known_vendors(void) {
+  TEST_ASSERT_EQUAL_UINT8(OUI_EXCLUDE, oui_lookup(0x240AC4)); // Espressif
+  TEST_ASSERT_EQUAL_UINT8(OUI_INCLUDE, oui_lookup(0xF0D1A9)); // Apple
+}
+
+void test_unknown_vendors(void) {
+  uint32_t hits = 0;
+  // every OUI not in the table must classify as none
+  for (uint32_t oui = 0; oui <= 0xFFFFFF; oui += 7) {
+    const uint8_t cls = oui_lookup(oui);
+    if (cls != OUI_NONE)
+      hits++;
+  }
+  TEST_ASSERT_TRUE(hits <= OUI_ENTRIES);
+  TEST_ASSERT_EQUAL_UINT8(OUI_NONE, oui_lookup(0x000000));
+  TEST_ASSERT_EQUAL_UINT8(OUI_NONE, oui_lookup(0xFFFFFF));
+}
+
+void test_bench_lookup(void) {
+  const uint32_t n = 20000000;
+  uint32_t excluded = 0;
+  char line[96];
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < n; i++) {
+    // mostly unknown OUIs, every 16th one from the table like in a real scan
+    const uint32_t oui = (i & 15) ? (i * 2654435761u) >> 8
+                                  : oui_table[i % (1u << OUI_TABLE_BITS)];
+    excluded += (oui_lookup(oui) == OUI_EXCLUDE);
+  }
+  auto stop = std::chrono::steady_clock::now();
+
+  TEST_ASSERT_TRUE(excluded > 0);
+  const double s = std::chrono::duration<double>(stop - start).count();
+  snprintf(line, sizeof(line), "%u OUIs: %.1f ns/lookup, %.1f M lookups/s",
+           OUI_ENTRIES, s * 1e9 / n, n / s / 1e6);
+  TEST_MESSAGE(line);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_oui_from_mac);
+  RUN_TEST(test_table_entries_are_found);
+  RUN_TEST(test_known_vendors);
+  RUN_TEST(test_unknown_vendors);
+  RUN_TEST(test_bench_lookup);
+  return UNITY_END();
+}
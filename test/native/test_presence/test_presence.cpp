@@ -0,0 +1,93 @@
+// host tests for the stationary device presence table
+// run with: pio test -e native -f native/test_presence -v
+
+#include <unity.h>
+
+#include "presence.h"
+
+#define SETS 16
+#define THRESHOLD 360
+#define GAP 15
+
+static presenceEntry_t slab[SETS * PRESENCE_WAYS];
+static PresenceTable table(slab, SETS, THRESHOLD, GAP);
+
+// one minute of a scan, all given tags are seen, then the table ages
+static void minute(const uint32_t *tags, uint32_t n) {
+  for (uint32_t i = 0; i < n; i++)
+    table.seen(tags[i]);
+  table.age(1);
+}
+
+void setUp(void) { table.clear(); }
+void tearDown(void) {}
+
+void test_excluded_after_threshold(void) {
+  const uint32_t tag = 0x12345678;
+  for (uint32_t m = 0; m < THRESHOLD - 1; m++)
+    minute(&tag, 1);
+  TEST_ASSERT_FALSE(table.seen(tag));
+  table.age(1);
+  TEST_ASSERT_TRUE(table.seen(tag));
+  TEST_ASSERT_EQUAL_UINT32(1, table.excluded());
+}
+
+void test_gap_restarts_presence(void) {
+  const uint32_t tag = 0x12345678;
+  for (uint32_t m = 0; m < THRESHOLD / 2; m++)
+    minute(&tag, 1);
+  table.age(GAP + 1); // away for longer than the gap
+  TEST_ASSERT_EQUAL_UINT32(0, table.size());
+  for (uint32_t m = 0; m < THRESHOLD / 2; m++)
+    minute(&tag, 1);
+  TEST_ASSERT_FALSE(table.seen(tag));
+}
+
+void test_short_gap_is_bridged(void) {
+  const uint32_t tag = 0x12345678;
+  for (uint32_t m = 0; m < THRESHOLD / 2; m++)
+    minute(&tag, 1);
+  table.age(GAP); // a short absence keeps counting
+  for (uint32_t m = 0; m < THRESHOLD / 2; m++)
+    minute(&tag, 1);
+  TEST_ASSERT_TRUE(table.seen(tag));
+}
+
+void test_excluded_kept_until_idle_saturates(void) {
+  const uint32_t tag = 0x12345678;
+  for (uint32_t m = 0; m < THRESHOLD; m++)
+    minute(&tag, 1);
+  table.age(120); // switched off for two hours
+  TEST_ASSERT_EQUAL_UINT32(1, table.excluded());
+  table.age(UINT8_MAX - 120);
+  TEST_ASSERT_EQUAL_UINT32(0, table.size());
+}
+
+void test_passers_by_do_not_evict_stationary(void) {
+  // a stationary device in each set, then a crowd of passers by, each
+  // minute four times as many as the table holds
+  uint32_t fixed[SETS];
+  for (uint32_t i = 0; i < SETS; i++)
+    fixed[i] = 0x1000 * (i + 1) + i;
+  for (uint32_t m = 0; m < 5; m++)
+    minute(fixed, SETS);
+  uint32_t visitor = 0x80000000;
+  for (uint32_t m = 5; m < THRESHOLD; m++) {
+    for (uint32_t v = 0; v < 4 * SETS * PRESENCE_WAYS; v++)
+      table.seen(visitor++);
+    minute(fixed, SETS);
+  }
+  TEST_ASSERT_EQUAL_UINT32(SETS, table.excluded());
+  for (uint32_t i = 0; i < SETS; i++)
+    TEST_ASSERT_TRUE(table.seen(fixed[i]));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_excluded_after_threshold);
+  RUN_TEST(test_gap_restarts_presence);
+  RUN_TEST(test_short_gap_is_bridged);
+  RUN_TEST(test_excluded_kept_until_idle_saturates);
+  RUN_TEST(test_passers_by_do_not_evict_stationary);
+  return UNITY_END();
+}
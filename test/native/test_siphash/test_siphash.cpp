@@ -0,0 +1,127 @@
+// host tests and throughput benchmark for the SipHash MAC anonymizer
+// run with: pio test -e native -f native/test_siphash -v
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+#include "siphash.h"
+
+// key 00 01 .. 0f of the SipHash reference vectors
+static const sipKey_t refkey = {0x0706050403020100ULL, 0x0f0e0d0c0b0a0908ULL};
+
+// Paul Hsieh's SuperFastHash as used by myhash() through RokkitHash, for
+// comparison only
+static uint32_t superfasthash(const char *data, int len) {
+  uint32_t hash = len, tmp;
+  uint16_t w0, w1;
+  int rem = len & 3;
+
+  for (len >>= 2; len > 0; len--) {
+    memcpy(&w0, data, 2);
+    memcpy(&w1, data + 2, 2);
+    hash += w0;
+    tmp = (w1 << 11) ^ hash;
+    hash = (hash << 16) ^ tmp;
+    data += 4;
+    hash += hash >> 11;
+  }
+  switch (rem) {
+  case 3:
+    memcpy(&w0, data, 2);
+    hash += w0;
+    hash ^= hash << 16;
+    hash ^= ((signed char)data[2]) << 18;
+    hash += hash >> 11;
+    break;
+  case 2:
+    memcpy(&w0, data, 2);
+    hash += w0;
+    hash ^= hash << 11;
+    hash += hash >> 17;
+    break;
+  case 1:
+    hash += (signed char)*data;
+    hash ^= hash << 10;
+    hash += hash >> 1;
+  }
+  hash ^= hash << 3;
+  hash += hash >> 5;
+  hash ^= hash << 4;
+  hash += hash >> 17;
+  hash ^= hash << 25;
+  hash += hash >> 6;
+  return hash;
+}
+
+static void test_mac(uint32_t i, uint8_t mac[6]) {
+  const uint32_t nic = i * 2654435761u;
+  mac[0] = 0x3C, mac[1] = 0x2E, mac[2] = 0xFF;
+  mac[3] = nic >> 16, mac[4] = nic >> 8, mac[5] = nic;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_reference_vectors(void) {
+  uint8_t msg[16];
+  for (uint8_t i = 0; i < sizeof(msg); i++)
+    msg[i] = i;
+  TEST_ASSERT_EQUAL_HEX64(0x726fdb47dd0e0e31ULL, siphash24(&refkey, msg, 0));
+  TEST_ASSERT_EQUAL_HEX64(0xcbc9466e58fee3ceULL, siphash24(&refkey, msg, 6));
+  TEST_ASSERT_EQUAL_HEX64(0x93f5f5799a932462ULL, siphash24(&refkey, msg, 8));
+}
+
+void test_mac_variant_matches(void) {
+  uint8_t mac[6];
+  for (uint32_t i = 0; i < 1000; i++) {
+    test_mac(i, mac);
+    TEST_ASSERT_EQUAL_HEX64(siphash24(&refkey, mac, 6),
+                            siphash24_mac(&refkey, mac));
+  }
+}
+
+void test_salt_changes_keys(void) {
+  const sipKey_t other = {refkey.k0 ^ 1, refkey.k1};
+  uint8_t mac[6];
+  test_mac(42, mac);
+  TEST_ASSERT_TRUE(siphash24_mac(&refkey, mac) != siphash24_mac(&other, mac));
+}
+
+void test_bench_throughput(void) {
+  const uint32_t n = 10000000;
+  uint8_t macs[256][6];
+  uint64_t sum = 0;
+  char line[96];
+
+  for (uint32_t i = 0; i < 256; i++)
+    test_mac(i, macs[i]);
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < n; i++)
+    sum += siphash24_mac(&refkey, macs[i & 255]);
+  auto mid = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < n; i++)
+    sum += superfasthash((const char *)macs[i & 255], 6);
+  auto stop = std::chrono::steady_clock::now();
+
+  TEST_ASSERT_TRUE(sum != 0);
+  const double sip = std::chrono::duration<double>(mid - start).count();
+  const double sfh = std::chrono::duration<double>(stop - mid).count();
+  snprintf(line, sizeof(line), "SipHash-2-4:   %5.1f ns/MAC, %6.1f M MACs/s",
+           sip * 1e9 / n, n / sip / 1e6);
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "SuperFastHash: %5.1f ns/MAC, %6.1f M MACs/s",
+           sfh * 1e9 / n, n / sfh / 1e6);
+  TEST_MESSAGE(line);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_reference_vectors);
+  RUN_TEST(test_mac_variant_matches);
+  RUN_TEST(test_salt_changes_keys);
+  RUN_TEST(test_bench_throughput);
+  return UNITY_END();
+}
@@ -0,0 +1,157 @@
+// host tests for sketch export packets and benchmark of merging sketches
+// of many devices
+// run with: pio test -e native -f native/test_sketchcodec -v
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+#include "hyperloglog.h"
+#include "sketchcodec.h"
+
+#define P 10
+#define M (1U << P)
+
+// splitmix64, like a keyed hash of a MAC shared by all devices of a site
+static uint64_t key(uint64_t i) {
+  uint64_t z = i + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// sketch of devices first .. last - 1 as packets of at most size bytes,
+// returns number of packets written to pkt
+static uint16_t export_sketch(uint32_t first, uint32_t last, bool packed,
+                              uint16_t size, uint8_t pkt[][256],
+                              uint16_t len[], uint32_t stamp = 1700000000) {
+  static uint8_t regs[M];
+  HyperLogLog hll(regs, P);
+  for (uint32_t i = first; i < last; i++)
+    hll.add(key(i));
+
+  sketchHeader_t h = {stamp, P, packed, 0, 0};
+  const uint16_t chunk = sketch_chunk(size, packed);
+  uint16_t n = 0;
+  for (h.first = 0; h.first < M; h.first += chunk, n++) {
+    h.count = (M - h.first < chunk) ? M - h.first : chunk;
+    len[n] = sketch_encode(pkt[n], &h, regs);
+  }
+  return n;
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_chunk_sizes(void) {
+  TEST_ASSERT_EQUAL_UINT16(44, sketch_chunk(51, false));
+  TEST_ASSERT_EQUAL_UINT16(56, sketch_chunk(51, true));
+  TEST_ASSERT_EQUAL_UINT16(76, sketch_chunk(64, true));
+  TEST_ASSERT_EQUAL_UINT16(0, sketch_chunk(SKETCH_HEADER_SIZE, true));
+}
+
+void test_roundtrip(void) {
+  static uint8_t pkt[64][256], regs[M], ref[M];
+  uint16_t len[64];
+  HyperLogLog hll(ref, P);
+  for (uint32_t i = 0; i < 5000; i++)
+    hll.add(key(i));
+
+  for (uint8_t packed = 0; packed < 2; packed++) {
+    const uint16_t n = export_sketch(0, 5000, packed, 51, pkt, len);
+    memset(regs, 0, sizeof(regs));
+    for (uint16_t i = 0; i < n; i++)
+      TEST_ASSERT_TRUE(sketch_merge(pkt[i], len[i], regs, P));
+    TEST_ASSERT_EQUAL_MEMORY(ref, regs, M);
+  }
+}
+
+void test_rejects_malformed(void) {
+  static uint8_t pkt[64][256], regs[M];
+  uint16_t len[64];
+  export_sketch(0, 100, true, 51, pkt, len);
+  TEST_ASSERT_FALSE(sketch_merge(pkt[0], len[0], regs, P + 1));
+  TEST_ASSERT_FALSE(sketch_merge(pkt[0], len[0] - 1, regs, P));
+  TEST_ASSERT_FALSE(sketch_merge(pkt[0], SKETCH_HEADER_SIZE, regs, P));
+  pkt[0][5] = 0xFF; // first register beyond sketch
+  TEST_ASSERT_FALSE(sketch_merge(pkt[0], len[0], regs, P));
+}
+
+void test_stamp_shared_by_devices(void) {
+  // 60 s cycles ending anywhere in the second half of a window, or the
+  // first half of the next one, are stamped with the window's start
+  TEST_ASSERT_EQUAL_UINT32(1700000040, sketch_stamp(1700000070, 60));
+  TEST_ASSERT_EQUAL_UINT32(1700000040, sketch_stamp(1700000129, 60));
+  TEST_ASSERT_EQUAL_UINT32(1700000100, sketch_stamp(1700000130, 60));
+  TEST_ASSERT_EQUAL_UINT32(0, sketch_stamp(30, 60));
+  TEST_ASSERT_EQUAL_UINT32(0, sketch_stamp(1700000070, 0));
+
+  static uint8_t pkt[64][256];
+  uint16_t len[64];
+  sketchHeader_t h;
+  const uint32_t stamp = sketch_stamp(1700000070, 60);
+  const uint16_t n = export_sketch(0, 100, true, 51, pkt, len, stamp);
+  for (uint16_t i = 0; i < n; i++) {
+    TEST_ASSERT_TRUE(sketch_header(pkt[i], len[i], &h));
+    TEST_ASSERT_EQUAL_UINT32(stamp, h.stamp);
+  }
+}
+
+void test_union_of_overlapping_nodes(void) {
+  // three nodes, each sees 2000 devices, neighbours share 1000
+  static uint8_t pkt[64][256], regs[M];
+  uint16_t len[64];
+  HyperLogLog merged(regs, P);
+  for (uint32_t node = 0; node < 3; node++) {
+    const uint16_t n =
+        export_sketch(node * 1000, node * 1000 + 2000, true, 242, pkt, len);
+    for (uint16_t i = 0; i < n; i++)
+      TEST_ASSERT_TRUE(sketch_merge(pkt[i], len[i], regs, P));
+  }
+  // 4000 unique instead of 6000 summed, error 1.04 / sqrt(1024) = 3.3%
+  TEST_ASSERT_UINT32_WITHIN(400, 4000, merged.estimate());
+}
+
+void test_bench_merge_1000(void) {
+  // 1000 nodes of a large site, sketches as received, packed in 242 bytes
+  const uint16_t nodes = 1000;
+  static uint8_t pkt[1000][6][256], regs[M];
+  static uint16_t len[1000][6], npkt[1000];
+  for (uint16_t d = 0; d < nodes; d++)
+    npkt[d] = export_sketch(d * 50, d * 50 + 500, true, 242, pkt[d], len[d]);
+
+  const int rounds = 20;
+  uint32_t estimate = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    memset(regs, 0, sizeof(regs));
+    HyperLogLog merged(regs, P, true);
+    for (uint16_t d = 0; d < nodes; d++)
+      for (uint16_t i = 0; i < npkt[d]; i++)
+        sketch_merge(pkt[d][i], len[d][i], regs, P);
+    estimate = merged.estimate();
+  }
+  auto stop = std::chrono::steady_clock::now();
+
+  char line[96];
+  const double ms =
+      std::chrono::duration<double, std::milli>(stop - start).count() / rounds;
+  snprintf(line, sizeof(line),
+           "%u sketches of 2^%u registers: %.2f ms per merge, estimate %u",
+           nodes, P, ms, estimate);
+  TEST_MESSAGE(line);
+  // 50450 devices in total
+  TEST_ASSERT_UINT32_WITHIN(5000, 50450, estimate);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_chunk_sizes);
+  RUN_TEST(test_roundtrip);
+  RUN_TEST(test_rejects_malformed);
+  RUN_TEST(test_stamp_shared_by_devices);
+  RUN_TEST(test_union_of_overlapping_nodes);
+  RUN_TEST(test_bench_merge_1000);
+  return UNITY_END();
+}
@@ -0,0 +1,86 @@
+// host tests for the sliding window unique counts
+// run with: pio test -e native -f native/test_slidingwindow -v
+
+#include <string.h>
+#include <unity.h>
+
+#include "slidingwindow.h"
+
+static StaticSlidingWindow<5, 10> window(60);
+
+// splitmix64, well mixed keys like the anonymized MACs
+static uint64_t key(uint64_t i) {
+  uint64_t z = i + 0x9E3779B97F4A7C15ULL;
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// devices first .. last - 1, each seen a few times at second now
+static void seen(uint32_t first, uint32_t last, uint32_t now) {
+  for (uint8_t r = 0; r < 3; r++)
+    for (uint32_t i = first; i < last; i++)
+      window.add(key(i), now);
+}
+
+void setUp(void) { window.clear(); }
+void tearDown(void) {}
+
+void test_rollover_keeps_last_slot(void) {
+  seen(0, 500, 30);
+  TEST_ASSERT_UINT32_WITHIN(25, 500, window.count(1, 59));
+  // next slot has just started and is still empty
+  TEST_ASSERT_UINT32_WITHIN(25, 500, window.count(1, 61));
+  // two slot periods later the devices have left the 1 slot horizon
+  TEST_ASSERT_UINT32_WITHIN(25, 500, window.count(2, 121));
+  TEST_ASSERT_EQUAL_UINT32(0, window.count(1, 121));
+}
+
+void test_horizons_are_nested(void) {
+  seen(0, 400, 10);
+  seen(300, 700, 70);
+  seen(600, 1000, 130);
+  TEST_ASSERT_UINT32_WITHIN(25, 400, window.count(0, 130));
+  TEST_ASSERT_UINT32_WITHIN(35, 700, window.count(1, 130));
+  TEST_ASSERT_UINT32_WITHIN(50, 1000, window.count(2, 130));
+  TEST_ASSERT_UINT32_WITHIN(50, 1000, window.count(100, 130));
+}
+
+void test_long_gap_clears(void) {
+  seen(0, 500, 10);
+  TEST_ASSERT_EQUAL_UINT32(0, window.count(4, 10 + 60 * 6));
+}
+
+void test_copy_matches_count(void) {
+  uint8_t slot[1 << 10], sum[1 << 10];
+  seen(0, 400, 10);
+  seen(300, 700, 70);
+  HyperLogLog total(sum, 10);
+  for (uint16_t ago = 0; ago < 3; ago++) {
+    window.copy(ago, 130, slot);
+    total.merge(HyperLogLog(slot, 10, true));
+  }
+  TEST_ASSERT_EQUAL_UINT32(window.count(2, 130), total.estimate());
+}
+
+void test_copy_outside_ring_is_empty(void) {
+  uint8_t slot[1 << 10], zero[1 << 10];
+  memset(zero, 0, sizeof(zero));
+  seen(0, 100, 250);
+  window.copy(5, 250, slot); // older than the ring
+  TEST_ASSERT_EQUAL_MEMORY(zero, slot, sizeof(slot));
+  window.copy(0, 310, slot); // slot not reached yet
+  TEST_ASSERT_EQUAL_MEMORY(zero, slot, sizeof(slot));
+  window.copy(1, 310, slot);
+  TEST_ASSERT_FALSE(memcmp(zero, slot, sizeof(slot)) == 0);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_rollover_keeps_last_slot);
+  RUN_TEST(test_horizons_are_nested);
+  RUN_TEST(test_long_gap_clears);
+  RUN_TEST(test_copy_matches_count);
+  RUN_TEST(test_copy_outside_ring_is_empty);
+  return UNITY_END();
+}
@@ -0,0 +1,139 @@
+// host tests and stress test for the sniffer handoff ring
+// run with: pio test -e native -f native/test_spscring -v
+
+#include <unity.h>
+#include <stdio.h>
+#include <chrono>
+#include <thread>
+
+#include "spscring.h"
+
+// same layout as detection_t of the firmware
+typedef struct {
+  uint64_t key;
+  uint32_t time;
+  int8_t rssi;
+  uint8_t channel;
+  uint8_t frame_class;
+  uint8_t flags;
+} record_t;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_push_pop_order(void) {
+  SpscRing<record_t, 8> ring;
+  record_t r = {}, out[8];
+
+  for (uint32_t i = 0; i < 5; i++) {
+    r.key = i;
+    TEST_ASSERT_TRUE(ring.push(r));
+  }
+  TEST_ASSERT_EQUAL_UINT32(5, ring.size());
+  TEST_ASSERT_EQUAL_UINT32(3, ring.pop(out, 3));
+  for (uint32_t i = 0; i < 3; i++)
+    TEST_ASSERT_EQUAL_UINT32(i, (uint32_t)out[i].key);
+  TEST_ASSERT_EQUAL_UINT32(2, ring.pop(out, 8));
+  TEST_ASSERT_EQUAL_UINT32(4, (uint32_t)out[1].key);
+  TEST_ASSERT_EQUAL_UINT32(0, ring.pop(out, 8));
+}
+
+void test_overflow_is_counted(void) {
+  SpscRing<record_t, 4> ring;
+  record_t r = {}, out[4];
+
+  for (uint32_t i = 0; i < 6; i++) {
+    r.key = i;
+    ring.push(r);
+  }
+  TEST_ASSERT_EQUAL_UINT32(4, ring.size());
+  TEST_ASSERT_EQUAL_UINT32(4, ring.pushed());
+  TEST_ASSERT_EQUAL_UINT32(2, ring.dropped());
+  // oldest records are kept, ring stays usable after overflow
+  TEST_ASSERT_EQUAL_UINT32(4, ring.pop(out, 4));
+  TEST_ASSERT_EQUAL_UINT32(3, (uint32_t)out[3].key);
+  TEST_ASSERT_TRUE(ring.push(r));
+}
+
+void test_wraparound(void) {
+  SpscRing<record_t, 4> ring;
+  record_t r = {}, out[4];
+
+  for (uint32_t i = 0; i < 1000; i++) {
+    r.key = i;
+    TEST_ASSERT_TRUE(ring.push(r));
+    TEST_ASSERT_EQUAL_UINT32(1, ring.pop(out, 4));
+    TEST_ASSERT_EQUAL_UINT32(i, (uint32_t)out[0].key);
+  }
+}
+
+// producer and consumer on own threads, every record must arrive once, in
+// order and intact, or be counted as dropped. A paced producer waits for
+// space like a burst the worker keeps up with, a flooding one overruns it.
+static void stress(bool paced) {
+  static SpscRing<record_t, 256> ring;
+  const uint32_t n = paced ? 200000 : 5000000;
+  const uint32_t dropped0 = ring.dropped(), pushed0 = ring.pushed();
+  uint32_t received = 0, errors = 0;
+  char line[96];
+
+  auto start = std::chrono::steady_clock::now();
+  std::thread producer([&]() {
+    record_t r = {};
+    for (uint32_t i = 0; i < n; i++) {
+      r.key = ((uint64_t)i << 32) | ~i;
+      r.time = i;
+      r.rssi = (int8_t)i;
+      while (paced && (ring.size() >= ring.capacity()))
+        std::this_thread::yield();
+      ring.push(r);
+    }
+  });
+  std::thread consumer([&]() {
+    record_t batch[32];
+    uint32_t last = 0;
+    bool first = true;
+    while (received + ring.dropped() - dropped0 < n) {
+      const uint32_t got = ring.pop(batch, 32);
+      for (uint32_t i = 0; i < got; i++) {
+        const uint32_t seq = batch[i].time;
+        if ((batch[i].key != (((uint64_t)seq << 32) | (uint32_t)~seq)) ||
+            (batch[i].rssi != (int8_t)seq) || (!first && seq <= last))
+          errors++;
+        last = seq;
+        first = false;
+      }
+      received += got;
+    }
+  });
+  producer.join();
+  consumer.join();
+  auto stop = std::chrono::steady_clock::now();
+
+  const uint32_t dropped = ring.dropped() - dropped0;
+  TEST_ASSERT_EQUAL_UINT32(0, errors);
+  TEST_ASSERT_EQUAL_UINT32(n, received + dropped);
+  TEST_ASSERT_EQUAL_UINT32(received, ring.pushed() - pushed0);
+  TEST_ASSERT_EQUAL_UINT32(0, ring.size());
+  if (paced)
+    TEST_ASSERT_EQUAL_UINT32(0, dropped);
+
+  const double s = std::chrono::duration<double>(stop - start).count();
+  snprintf(line, sizeof(line),
+           "%s: %u received, %u dropped, %.1f M records/s",
+           paced ? "paced" : "flood", received, dropped, n / s / 1e6);
+  TEST_MESSAGE(line);
+}
+
+void test_stress_paced(void) { stress(true); }
+void test_stress_flood(void) { stress(false); }
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_push_pop_order);
+  RUN_TEST(test_overflow_is_counted);
+  RUN_TEST(test_wraparound);
+  RUN_TEST(test_stress_paced);
+  RUN_TEST(test_stress_flood);
+  return UNITY_END();
+}
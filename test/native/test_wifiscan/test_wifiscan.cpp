@@ -0,0 +1,196 @@
+// host tests for the non blocking WiFi scan state machine, using a mocked
+// scan backend
+// run with: pio test -e native -f native/test_wifiscan -v
+
+#include <atomic>
+#include <thread>
+#include <unity.h>
+
+#include "wifiscan.h"
+
+// mock backend, a scan returns mock_results devices after mock_polls polls
+static int starts, releases, polls_left;
+static int16_t mock_results;
+static bool mock_start_ok;
+static WifiScan::State start_state;
+static WifiScan::State scan_state(void);
+
+static bool mock_start(void) {
+  starts++;
+  start_state = scan_state();
+  return mock_start_ok;
+}
+
+static int16_t mock_status(void) {
+  if (polls_left > 0) {
+    polls_left--;
+    return WIFISCAN_RUNNING;
+  }
+  return mock_results;
+}
+
+static bool mock_result(int16_t i, DeviceInfo *info) {
+  info->mac = 0xAABBCC000000ULL | (uint64_t)i;
+  info->rssi = -40 - i % 50;
+  info->channel = 1 + i % 13;
+  return true;
+}
+
+static void mock_release(void) { releases++; }
+
+static const WifiScanBackend backend = {mock_start, mock_status, mock_result,
+                                        mock_release};
+static StaticWifiScan<8> scan(&backend);
+
+static WifiScan::State scan_state(void) { return scan.state(); }
+
+static std::atomic<int> callbacks;
+static uint16_t cb_count, cb_dropped;
+
+static void on_done(const DeviceInfo *devices, uint16_t count,
+                    uint16_t dropped) {
+  callbacks++;
+  cb_count = count;
+  cb_dropped = dropped;
+}
+
+// polls until the scan completes, false if it never does
+static bool wait_done(void) {
+  for (int i = 0; i < 100; i++)
+    if (scan.poll())
+      return true;
+  return false;
+}
+
+void setUp(void) {
+  starts = releases = callbacks = 0;
+  polls_left = 2;
+  mock_results = 5;
+  mock_start_ok = true;
+  cb_count = cb_dropped = 0;
+  scan.reset();
+  scan.onComplete(on_done);
+}
+void tearDown(void) {}
+
+void test_one_scan_per_trigger(void) {
+  TEST_ASSERT_TRUE(scan.trigger());
+  TEST_ASSERT_EQUAL(1, starts);
+  TEST_ASSERT_EQUAL(WifiScan::RUNNING, scan.state());
+
+  // triggers while running don't start another scan
+  TEST_ASSERT_FALSE(scan.trigger());
+  TEST_ASSERT_FALSE(scan.trigger());
+  TEST_ASSERT_EQUAL(1, starts);
+
+  TEST_ASSERT_FALSE(scan.poll());
+  TEST_ASSERT_FALSE(scan.poll());
+  TEST_ASSERT_EQUAL(0, callbacks);
+  TEST_ASSERT_TRUE(scan.poll());
+  TEST_ASSERT_EQUAL(1, callbacks);
+  TEST_ASSERT_EQUAL(1, releases);
+  TEST_ASSERT_EQUAL(WifiScan::IDLE, scan.state());
+
+  // no further scan without trigger
+  TEST_ASSERT_FALSE(scan.poll());
+  TEST_ASSERT_EQUAL(1, starts);
+  TEST_ASSERT_EQUAL(1, callbacks);
+
+  for (int i = 0; i < 10; i++) {
+    polls_left = 0;
+    TEST_ASSERT_TRUE(scan.trigger());
+    TEST_ASSERT_TRUE(scan.poll());
+  }
+  TEST_ASSERT_EQUAL(11, starts);
+  TEST_ASSERT_EQUAL(11, callbacks);
+}
+
+void test_results_in_buffer(void) {
+  TEST_ASSERT_TRUE(scan.trigger());
+  TEST_ASSERT_TRUE(wait_done());
+  TEST_ASSERT_EQUAL(5, cb_count);
+  TEST_ASSERT_EQUAL(0, cb_dropped);
+  TEST_ASSERT_EQUAL(5, scan.count());
+  TEST_ASSERT_EQUAL_HEX64(0xAABBCC000003ULL, scan.results()[3].mac);
+  TEST_ASSERT_EQUAL(-43, scan.results()[3].rssi);
+  TEST_ASSERT_EQUAL(4, scan.results()[3].channel);
+}
+
+void test_buffer_overflow(void) {
+  mock_results = 20;
+  TEST_ASSERT_TRUE(scan.trigger());
+  TEST_ASSERT_TRUE(wait_done());
+  TEST_ASSERT_EQUAL(8, cb_count);
+  TEST_ASSERT_EQUAL(12, cb_dropped);
+}
+
+void test_failed_scan(void) {
+  mock_results = WIFISCAN_FAILED;
+  TEST_ASSERT_TRUE(scan.trigger());
+  TEST_ASSERT_TRUE(wait_done());
+  TEST_ASSERT_EQUAL(1, callbacks);
+  TEST_ASSERT_EQUAL(0, cb_count);
+  TEST_ASSERT_EQUAL(WifiScan::IDLE, scan.state());
+}
+
+void test_start_error(void) {
+  mock_start_ok = false;
+  TEST_ASSERT_FALSE(scan.trigger());
+  TEST_ASSERT_EQUAL(1, starts);
+  TEST_ASSERT_EQUAL(WifiScan::IDLE, scan.state());
+  TEST_ASSERT_FALSE(scan.poll());
+  TEST_ASSERT_EQUAL(0, callbacks);
+}
+
+void test_running_during_start(void) {
+  // completion may be reported before start returns
+  TEST_ASSERT_TRUE(scan.trigger());
+  TEST_ASSERT_EQUAL(WifiScan::RUNNING, start_state);
+  mock_start_ok = false;
+  scan.reset();
+  TEST_ASSERT_FALSE(scan.trigger());
+  TEST_ASSERT_EQUAL(WifiScan::IDLE, scan.state());
+}
+
+void test_poll_from_other_task(void) {
+  // scan done events are polled by another task than the one triggering
+  polls_left = 0;
+  std::atomic<bool> done(false);
+  std::thread events([&] {
+    while (!done)
+      scan.poll();
+  });
+  for (int i = 0; i < 1000; i++)
+    while (!scan.trigger())
+      ;
+  while (scan.state() != WifiScan::IDLE)
+    ;
+  done = true;
+  events.join();
+  TEST_ASSERT_EQUAL(1000, starts);
+  TEST_ASSERT_EQUAL(1000, callbacks);
+  TEST_ASSERT_EQUAL(1000, releases);
+}
+
+void test_reset_abandons_scan(void) {
+  scan.trigger();
+  scan.reset();
+  TEST_ASSERT_EQUAL(1, releases);
+  TEST_ASSERT_FALSE(scan.poll());
+  TEST_ASSERT_EQUAL(0, callbacks);
+  TEST_ASSERT_TRUE(scan.trigger());
+  TEST_ASSERT_EQUAL(2, starts);
+}
+
+int main(void) {
+  UNITY_BEGIN();
+  RUN_TEST(test_one_scan_per_trigger);
+  RUN_TEST(test_results_in_buffer);
+  RUN_TEST(test_buffer_overflow);
+  RUN_TEST(test_failed_scan);
+  RUN_TEST(test_start_error);
+  RUN_TEST(test_running_during_start);
+  RUN_TEST(test_poll_from_other_task);
+  RUN_TEST(test_reset_abandons_scan);
+  return UNITY_END();
+}
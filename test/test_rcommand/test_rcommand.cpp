@@ -0,0 +1,64 @@
+#include <unity.h>
+#include <rcommand.h>
+
+// remote command interpreter, runs in rcmd task on the device
+void rcmd_execute(const uint8_t cmd[], const uint8_t cmdlength);
+
+void test_transaction_rejects_rssi_out_of_range() {
+    cfg.rssilimit = -70;
+    cfg.sendcycle = 30;
+
+    // send cycle is valid, but rssi limit -200 dBm is not: nothing applied
+    const uint8_t txn[] = {RCMD_TRANSACTION, 0x0a, 60, 0x01, 200};
+    rcmd_execute(txn, sizeof(txn));
+    TEST_ASSERT_EQUAL(-70, cfg.rssilimit);
+    TEST_ASSERT_EQUAL(30, cfg.sendcycle);
+
+    // lowest limit an int8 rssi can reach is accepted
+    const uint8_t ok[] = {RCMD_TRANSACTION, 0x0a, 60, 0x01, 128};
+    rcmd_execute(ok, sizeof(ok));
+    TEST_ASSERT_EQUAL(-128, cfg.rssilimit);
+    TEST_ASSERT_EQUAL(60, cfg.sendcycle);
+}
+
+void test_rejected_transaction_reports_nothing_committed() {
+    cfg.sendcycle = 30;
+
+    // second command has an unknown opcode
+    const uint8_t txn[] = {RCMD_TRANSACTION, 0x0a, 60, 0xff};
+    rcmd_execute(txn, sizeof(txn));
+    TEST_ASSERT_EQUAL(30, cfg.sendcycle);
+    TEST_ASSERT_EQUAL(4, payload.getSize());
+    const uint8_t *status = payload.getBuffer();
+    TEST_ASSERT_EQUAL(TXN_UNKNOWN, status[0]);
+    TEST_ASSERT_EQUAL(0, status[1]);    // committed
+    TEST_ASSERT_EQUAL(0xff, status[2]); // failing opcode
+    TEST_ASSERT_EQUAL(1, status[3]);    // index of failing command
+}
+
+void test_empty_transaction_ignored() {
+    payload.reset();
+    const uint8_t txn[] = {RCMD_TRANSACTION};
+    rcmd_execute(txn, sizeof(txn));
+    TEST_ASSERT_EQUAL(0, payload.getSize());
+}
+
+void test_single_command_rejects_rssi_out_of_range() {
+    cfg.rssilimit = -70;
+    const uint8_t cmd[] = {0x01, 129};
+    rcmd_execute(cmd, sizeof(cmd));
+    TEST_ASSERT_EQUAL(-70, cfg.rssilimit);
+}
+
+void setup() {
+    UNITY_BEGIN();
+    RUN_TEST(test_transaction_rejects_rssi_out_of_range);
+    RUN_TEST(test_rejected_transaction_reports_nothing_committed);
+    RUN_TEST(test_empty_transaction_ignored);
+    RUN_TEST(test_single_command_rejects_rssi_out_of_range);
+    UNITY_END();
+}
+
+void loop() {
+    // Empty loop
+}
@@ -4,20 +4,19 @@
 // Mock functions to simulate WiFi behavior
 void mock_startWifiScan() {
     // Simulate detected devices
-    detectedDevices[0] = {"AA:BB:CC:DD:EE:FF", -50};
-    detectedDevices[1] = {"AA:BB:CC:DD:EE:FF", -60}; // Duplicate
-    detectedDevices[2] = {"11:22:33:44:55:66", -70};
+    detectedDevices[0] = {0xAABBCCDDEEFFULL, -50};
+    detectedDevices[1] = {0xAABBCCDDEEFFULL, -60}; // Duplicate
+    detectedDevices[2] = {0x112233445566ULL, -70};
     deviceCount = 3;
 }
 
 void test_analyzeDetectedDevices() {
     mock_startWifiScan(); // Prepare mock data
-    analyzeDetectedDevices(); // Call the function to analyze devices
+    uint16_t unique = analyzeDetectedDevices(); // Call the function to analyze devices
 
-    // Check for expected log output or behavior
-    // This would typically involve checking logs or state changes
-    // For simplicity, we can just assert that deviceCount is correct
+    // raw scan results are kept, duplicates are only counted once
     TEST_ASSERT_EQUAL(3, deviceCount);
+    TEST_ASSERT_EQUAL(2, unique);
 }
 
 void setup() {
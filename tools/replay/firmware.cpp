@@ -0,0 +1,28 @@
+// Stand-ins for firmware modules outside of the counting path, which need
+// hardware: reset and sleep, the irq handler, the rcommand queue and time
+// keeping. See replay.cpp for the modules built from src/.
+
+#include "globals.h"
+#include "reset.h"
+#include "irqhandler.h"
+#include "rcommand.h"
+#include "timekeeper.h"
+
+RTC_NOINIT_ATTR runmode_t RTC_runmode = RUNMODE_POWERCYCLE;
+RTC_NOINIT_ATTR uint32_t RTC_restarts = 0;
+timesource_t timeSource = _unsynced;
+
+// no irq handler task, the replay calls sendData() itself
+TaskHandle_t irqHandlerTask = NULL;
+
+void reset_rtc_vars(void) {
+  RTC_runmode = RUNMODE_POWERCYCLE;
+  RTC_restarts = 0;
+  station_invalidate();
+}
+
+uint64_t uptime(void) { return millis(); }
+
+void rcmd_queuereset(void) {}
+
+uint32_t rcmd_queuewaiting(void) { return 0; }
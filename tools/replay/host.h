@@ -0,0 +1,12 @@
+// clang-format off
+// hal file of the host build, see replay.cpp
+
+#ifndef _HOST_H
+#define _HOST_H
+
+#include <stdint.h>
+
+// no radio, display, sensors or storage: payloads are assembled by
+// sendData(), but SendPayload() has no send queue to put them in
+
+#endif
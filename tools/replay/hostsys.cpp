@@ -0,0 +1,220 @@
+// Host implementation of the Arduino, ESP-IDF and FreeRTOS stand-ins in
+// stubs/. Tasks run as threads, task notifications are condition variables.
+// Time does not pass by itself, the replay sets it from the trace.
+
+#include <Arduino.h>
+#include <esp_wifi.h>
+#include <esp_gap_ble_api.h>
+#include <esp_timer.h>
+#include <rom/crc.h>
+
+#include <stdarg.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "replay.h"
+
+int host_loglevel = ESP_LOG_WARN;
+wifi_promiscuous_cb_t host_wifi_cb = NULL;
+esp_gap_ble_cb_t host_ble_cb = NULL;
+
+static std::atomic<uint64_t> clockMs(0);
+
+void host_clock_set(uint64_t ms) { clockMs = ms; }
+
+unsigned long millis(void) { return clockMs; }
+
+unsigned long micros(void) { return clockMs * 1000; }
+
+int64_t esp_timer_get_time(void) { return clockMs * 1000; }
+
+// waits in real time, the virtual clock is unaffected
+void delay(uint32_t ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void vTaskDelay(TickType_t ticks) { delay(ticks * portTICK_PERIOD_MS); }
+
+// fixed seed, so runs over the same trace are repeatable
+uint32_t esp_random(void) {
+  static std::mutex lock;
+  static std::mt19937 rng(0x70617863);
+  std::lock_guard<std::mutex> guard(lock);
+  return rng();
+}
+
+void host_log(int level, const char *tag, const char *format, ...) {
+  static const char letter[] = "NEWIDV";
+  if (level > host_loglevel)
+    return;
+  char line[256];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(line, sizeof(line), format, args);
+  va_end(args);
+  fprintf(stderr, "%c %8lu.%03lu %s: %s\n", letter[level], millis() / 1000,
+          millis() % 1000, tag, line);
+}
+
+// reflected CRC-32 as in the ESP32 ROM
+uint32_t crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *buf++;
+    for (uint8_t i = 0; i < 8; i++)
+      crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+  }
+  return ~crc;
+}
+
+// tasks
+
+struct hostTask {
+  const char *name;
+  std::mutex lock;
+  std::condition_variable wake, idle;
+  uint32_t notify = 0;
+  bool waiting = false;
+};
+
+static thread_local hostTask *currentTask = NULL;
+struct hostTaskDeleted {}; // unwinds a task calling vTaskDelete(NULL)
+static std::mutex taskLock;
+static std::vector<hostTask *> tasks;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char *name,
+                                   uint32_t stack, void *param,
+                                   UBaseType_t prio, TaskHandle_t *handle,
+                                   BaseType_t core) {
+  hostTask *task = new hostTask;
+  task->name = name;
+  {
+    std::lock_guard<std::mutex> guard(taskLock);
+    tasks.push_back(task);
+  }
+  if (handle)
+    *handle = task;
+  // tasks return only by vTaskDelete(NULL), else the process ends with them
+  // running
+  std::thread([=] {
+    currentTask = task;
+    try {
+      code(param);
+    } catch (hostTaskDeleted &) {
+    }
+  }).detach();
+  return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+  if (task && (task != currentTask))
+    abort(); // other tasks are never deleted by the firmware
+  {
+    std::lock_guard<std::mutex> guard(taskLock);
+    tasks.erase(std::find(tasks.begin(), tasks.end(), currentTask));
+  }
+  throw hostTaskDeleted();
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait) {
+  hostTask *task = currentTask;
+  std::unique_lock<std::mutex> guard(task->lock);
+  if (!task->notify) {
+    task->waiting = true;
+    task->idle.notify_all();
+    if (wait == portMAX_DELAY)
+      task->wake.wait(guard, [task] { return task->notify != 0; });
+    else
+      task->wake.wait_for(guard, std::chrono::milliseconds(wait),
+                          [task] { return task->notify != 0; });
+    task->waiting = false;
+  }
+  const uint32_t value = task->notify;
+  if (value)
+    task->notify = clear ? 0 : value - 1;
+  return value;
+}
+
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value,
+                       eNotifyAction action) {
+  if (!task)
+    return pdFAIL;
+  std::lock_guard<std::mutex> guard(task->lock);
+  if (action == eSetBits)
+    task->notify |= value;
+  else if (action == eIncrement)
+    task->notify++;
+  task->wake.notify_one();
+  return pdPASS;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  return xTaskNotify(task, 0, eIncrement);
+}
+
+bool host_task_settle(const char *name) {
+  hostTask *task = NULL;
+  {
+    std::lock_guard<std::mutex> guard(taskLock);
+    for (hostTask *t : tasks)
+      if (!strcmp(t->name, name))
+        task = t;
+  }
+  if (!task)
+    return false;
+  std::unique_lock<std::mutex> guard(task->lock);
+  task->notify++;
+  task->wake.notify_one();
+  task->idle.wait(guard, [task] { return task->waiting && !task->notify; });
+  return true;
+}
+
+// radio drivers, the replay calls the registered callbacks
+
+esp_err_t esp_wifi_set_promiscuous(bool en) { return ESP_OK; }
+
+esp_err_t esp_wifi_set_promiscuous_rx_cb(wifi_promiscuous_cb_t cb) {
+  host_wifi_cb = cb;
+  return ESP_OK;
+}
+
+esp_err_t esp_wifi_set_channel(uint8_t primary, wifi_second_chan_t second) {
+  return ESP_OK;
+}
+
+esp_err_t esp_ble_gap_register_callback(esp_gap_ble_cb_t callback) {
+  host_ble_cb = callback;
+  return ESP_OK;
+}
+
+esp_err_t esp_ble_gap_set_scan_params(esp_ble_scan_params_t *scan_params) {
+  return ESP_OK;
+}
+
+esp_err_t esp_ble_gap_start_scanning(uint32_t duration) { return ESP_OK; }
+
+esp_err_t esp_ble_gap_stop_scanning(void) { return ESP_OK; }
+
+// timers are created and armed, but never fire
+
+struct esp_timer {
+  esp_timer_create_args_t args;
+};
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t *args,
+                           esp_timer_handle_t *handle) {
+  *handle = new esp_timer{*args};
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeout_us) {
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) { return ESP_OK; }
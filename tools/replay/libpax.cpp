@@ -0,0 +1,125 @@
+// libpax stand-in: counts distinct MACs of the frames handed to its sniffer
+// callbacks, per send cycle or cumulative like libpax. It has no report
+// timer, the replay ends a cycle by libpax_host_cycle().
+
+#include <libpax_api.h>
+#include <esp_wifi.h>
+#include <esp_gap_ble_api.h>
+
+#include <unordered_set>
+
+#include "replay.h"
+
+static std::mutex paxLock;
+static std::unordered_set<uint64_t> seen[2]; // wifi, ble
+static struct libpax_config_t config;
+static struct count_payload_t *storage = NULL;
+static void (*report)(void) = NULL;
+static int mode = 0;
+static bool running = false;
+
+extern "C" void wifi_sniffer_packet_handler(void *buff,
+                                            wifi_promiscuous_pkt_type_t type);
+extern "C" void gap_callback_handler(esp_gap_ble_cb_event_t event,
+                                     esp_ble_gap_cb_param_t *param);
+
+static uint64_t mac_key(const uint8_t *paddr) {
+  uint64_t key = 0;
+  memcpy(&key, paddr, 6);
+  return key;
+}
+
+static void count_add(uint8_t sniffer, const uint8_t *paddr) {
+  std::lock_guard<std::mutex> guard(paxLock);
+  if (running)
+    seen[sniffer].insert(mac_key(paddr));
+}
+
+// transmitter address of the 802.11 header
+void wifi_sniffer_packet_handler(void *buff, wifi_promiscuous_pkt_type_t type) {
+  const wifi_promiscuous_pkt_t *ppkt = (wifi_promiscuous_pkt_t *)buff;
+  count_add(0, ppkt->payload + 10);
+}
+
+void gap_callback_handler(esp_gap_ble_cb_event_t event,
+                          esp_ble_gap_cb_param_t *param) {
+  if ((event == ESP_GAP_BLE_SCAN_RESULT_EVT) &&
+      (param->scan_rst.search_evt == ESP_GAP_SEARCH_INQ_RES_EVT))
+    count_add(1, param->scan_rst.bda);
+}
+
+void libpax_default_config(struct libpax_config_t *configuration) {
+  memset(configuration, 0, sizeof(*configuration));
+  strcpy(configuration->wifi_my_country_str, "01");
+  configuration->wificounter = 1;
+  configuration->wifi_channel_map = WIFI_CHANNEL_ALL;
+  configuration->wifi_channel_switch_interval = 50;
+  configuration->blecounter = 1;
+  configuration->blescantime = 0;
+  configuration->blescanwindow = 80;
+  configuration->blescaninterval = 80;
+}
+
+int libpax_update_config(struct libpax_config_t *configuration) {
+  config = *configuration;
+  return 0;
+}
+
+void libpax_get_current_config(struct libpax_config_t *configuration) {
+  *configuration = config;
+}
+
+int libpax_counter_init(void (*callback)(void),
+                        struct count_payload_t *pax_count_storage,
+                        uint16_t pax_report_interval_sec, int countermode) {
+  report = callback;
+  storage = pax_count_storage;
+  mode = countermode;
+  return 0;
+}
+
+// registers the sniffer callbacks, the firmware hooks in front of them
+int libpax_counter_start(void) {
+  std::lock_guard<std::mutex> guard(paxLock);
+  seen[0].clear();
+  seen[1].clear();
+  running = true;
+  if (config.wificounter)
+    esp_wifi_set_promiscuous_rx_cb(&wifi_sniffer_packet_handler);
+  if (config.blecounter)
+    esp_ble_gap_register_callback(&gap_callback_handler);
+  return 0;
+}
+
+int libpax_counter_stop(void) {
+  std::lock_guard<std::mutex> guard(paxLock);
+  running = false;
+  return 0;
+}
+
+int libpax_counter_count(struct count_payload_t *count) {
+  std::lock_guard<std::mutex> guard(paxLock);
+  count->wifi_count = seen[0].size();
+  count->ble_count = seen[1].size();
+  count->pax = count->wifi_count + count->ble_count;
+  return 0;
+}
+
+// stores the count and calls the report callback, cyclic modes start over
+void libpax_host_cycle(void) {
+  if (!storage)
+    return;
+  libpax_counter_count(storage);
+  if (mode != 1) {
+    std::lock_guard<std::mutex> guard(paxLock);
+    seen[0].clear();
+    seen[1].clear();
+  }
+  if (report)
+    report();
+}
+
+uint32_t libpax_host_devices(void) {
+  std::lock_guard<std::mutex> guard(paxLock);
+  return seen[0].size() + seen[1].size();
+}
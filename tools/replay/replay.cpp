@@ -0,0 +1,385 @@
+// replay - host build of the counting path, fed by detection traces
+//
+// Runs the firmware modules from sniffer callbacks to sendData() payload
+// assembly on Linux: sniffer hook and worker task, device tables, sketches,
+// libpax glue and payload encoder, as configured in shared/paxcounter.conf.
+// Hardware, ESP-IDF and FreeRTOS are replaced by stand-ins in stubs/, libpax
+// by a counter of distinct MACs. The clock follows the trace, send cycles
+// and housekeeping happen at their trace times. Channel hopping and scan
+// timers do not run, frames of all channels are received.
+//
+// Input: one detection per line, mac,rssi,channel,timestamp[ms] with
+// channel 0 for BLE, sorted by timestamp; lines starting with # are skipped.
+// Without -f a synthetic trace of devices arriving and leaving is generated.
+//
+// Reports detections per second fed through the sniffer callbacks, latency
+// of sendData() per send cycle and peak memory.
+//
+// build: pio run -e replay, or
+//        g++ -std=gnu++17 -O2 -pthread -Itools/replay/stubs -Itools/replay
+//        -Iinclude -include tools/replay/host.h
+//        -include shared/paxcounter.conf -DPROGVERSION='"replay"'
+//        -DTAG=__FILE__ -o replay tools/replay/*.cpp <sources of [env:replay]>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "libpax_helpers.h"
+#include "sniffer.h"
+#include "replay.h"
+
+extern char __data_start, end; // linker symbols, static data and bss
+
+typedef struct {
+  uint64_t ms;
+  uint8_t mac[6];
+  int8_t rssi;
+  uint8_t channel; // 0 for ble
+} trace_t;
+
+typedef struct {
+  uint8_t mac[6];
+  int8_t rssi;
+  bool ble;
+  int64_t arrive, leave; // [ms]
+} device_t;
+
+static struct {
+  uint32_t devices = 1000;
+  uint32_t rate = 500; // detections per second of trace time
+  uint32_t duration = 3600; // [s]
+  uint32_t ble = 40;        // percent of devices
+  uint32_t random = 60;     // percent of devices with randomized MAC
+  uint32_t dwell = 900;     // [s] mean visit
+  uint32_t seed = 1;
+} synth;
+
+static std::vector<device_t> population;
+static std::mt19937_64 rng;
+static uint64_t synthCount = 0;
+
+static uint32_t uniform(uint32_t n) { return rng() % n; }
+
+static void synth_init(void) {
+  rng.seed(synth.seed);
+  std::exponential_distribution<double> visit(1.0 / synth.dwell);
+  population.resize(synth.devices);
+  for (device_t &d : population) {
+    const uint64_t r = rng();
+    memcpy(d.mac, &r, 6);
+    d.mac[0] &= ~0x01; // unicast
+    if (uniform(100) < synth.random)
+      d.mac[0] |= 0x02;
+    else
+      d.mac[0] &= ~0x02;
+    d.ble = uniform(100) < synth.ble;
+    d.rssi = -95 + (int8_t)uniform(50);
+    // visits started before the trace are present at its start
+    d.arrive = ((int64_t)uniform(synth.duration + synth.dwell) - synth.dwell) *
+               1000;
+    d.leave = d.arrive + (int64_t)(visit(rng) * 1000) + 1000;
+  }
+}
+
+// detections at a constant rate, each of a device present at that time
+static bool synth_next(trace_t *t) {
+  t->ms = synthCount * 1000 / synth.rate;
+  if (t->ms >= (uint64_t)synth.duration * 1000)
+    return false;
+  synthCount++;
+  const device_t *d = &population[uniform(population.size())];
+  for (uint8_t i = 0; i < 16; i++) {
+    const device_t *c = &population[uniform(population.size())];
+    if ((c->arrive <= (int64_t)t->ms) && ((int64_t)t->ms < c->leave)) {
+      d = c;
+      break;
+    }
+  }
+  memcpy(t->mac, d->mac, 6);
+  t->rssi = d->rssi + (int8_t)uniform(13) - 6;
+  t->channel = d->ble ? 0 : 1 + uniform(13);
+  return true;
+}
+
+// next valid line of the trace file, malformed lines are skipped
+static bool file_next(FILE *f, trace_t *t, uint32_t *lineno,
+                      uint32_t *skipped) {
+  char line[128];
+  while (fgets(line, sizeof(line), f)) {
+    (*lineno)++;
+    if (line[0] == '#' || line[0] == '\n' || line[0] == '\r')
+      continue;
+    unsigned m[6], channel;
+    int rssi;
+    unsigned long long ms;
+    if ((sscanf(line, "%x:%x:%x:%x:%x:%x,%d,%u,%llu", &m[0], &m[1], &m[2],
+                &m[3], &m[4], &m[5], &rssi, &channel, &ms) != 9) ||
+        (channel > 14) || (rssi < INT8_MIN) || (rssi > 0)) {
+      fprintf(stderr, "line %u: malformed detection, skipped\n", *lineno);
+      (*skipped)++;
+      continue;
+    }
+    for (uint8_t i = 0; i < 6; i++)
+      t->mac[i] = m[i];
+    t->rssi = rssi;
+    t->channel = channel;
+    t->ms = ms;
+    return true;
+  }
+  return false;
+}
+
+// hands a detection to the sniffer callback registered by the firmware, as
+// the radio drivers do
+static void feed(const trace_t *t) {
+  if (t->channel) {
+    if (!host_wifi_cb)
+      return;
+    // rx control and 802.11 header of a probe request
+    union {
+      wifi_promiscuous_pkt_t pkt;
+      uint8_t raw[sizeof(wifi_promiscuous_pkt_t) + 24];
+    } frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.pkt.rx_ctrl.rssi = t->rssi;
+    frame.pkt.rx_ctrl.channel = t->channel;
+    frame.pkt.rx_ctrl.sig_len = 24;
+    uint8_t *hdr = frame.raw + sizeof(wifi_promiscuous_pkt_t);
+    hdr[0] = 0x40;
+    memcpy(hdr + 10, t->mac, 6);
+    host_wifi_cb(&frame, WIFI_PKT_MGMT);
+  } else {
+    if (!host_ble_cb)
+      return;
+    esp_ble_gap_cb_param_t param;
+    memset(&param, 0, sizeof(param));
+    param.scan_rst.search_evt = ESP_GAP_SEARCH_INQ_RES_EVT;
+    memcpy(param.scan_rst.bda, t->mac, 6);
+    param.scan_rst.ble_evt_type = ESP_BLE_EVT_CONN_ADV;
+    param.scan_rst.ble_addr_type =
+        (t->mac[0] & 0x02) ? BLE_ADDR_TYPE_RANDOM : BLE_ADDR_TYPE_PUBLIC;
+    param.scan_rst.rssi = t->rssi;
+    host_ble_cb(ESP_GAP_BLE_SCAN_RESULT_EVT, &param);
+  }
+}
+
+// firmware start as in main.cpp, counting path only
+static void boot(int countermode, int sendcycle, int rssilimit) {
+  loadConfig();
+  if (countermode >= 0)
+    cfg.countermode = countermode;
+  if (sendcycle > 0)
+    cfg.sendcycle = (sendcycle + 1) / 2;
+  if (rssilimit <= 0)
+    cfg.rssilimit = rssilimit;
+
+  struct libpax_config_t configuration;
+  libpax_default_config(&configuration);
+  strcpy(configuration.wifi_my_country_str, WIFI_MY_COUNTRY);
+  configuration.wificounter = cfg.wifiscan;
+  configuration.wifi_channel_map = cfg.wifichanmap;
+  configuration.wifi_channel_switch_interval = cfg.wifichancycle;
+  configuration.wifi_rssi_threshold = cfg.rssilimit;
+  configuration.blecounter = cfg.blescan;
+  configuration.blescantime = cfg.blescantime;
+  configuration.ble_rssi_threshold = cfg.rssilimit;
+
+  anon_init();
+  station_init();
+  export_init();
+  libpax_update_config(&configuration);
+  init_libpax();
+}
+
+static double percentile(const std::vector<double> &sorted, double p) {
+  return sorted.empty() ? 0 : sorted[(size_t)(p * (sorted.size() - 1))];
+}
+
+static void usage(void) {
+  fprintf(stderr,
+          "usage: replay [-f trace] [-n devices] [-r rate] [-d seconds]\n"
+          "              [-b blepercent] [-R randompercent] [-w dwell]\n"
+          "              [-s seed] [-x speed] [-c sendcycle] [-m mode]\n"
+          "              [-l rssilimit] [-v loglevel] [-C]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  const char *file = NULL;
+  double speed = 0; // trace time per wall time, 0 = unpaced
+  int countermode = -1, sendcycle = 0, rssilimit = 1;
+  bool cycles = false;
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    if (!strcmp(arg, "-C")) {
+      cycles = true;
+      continue;
+    }
+    if ((arg[0] != '-') || !arg[1] || arg[2] || (i + 1 >= argc))
+      usage();
+    const char *val = argv[++i];
+    switch (arg[1]) {
+    case 'f':
+      file = val;
+      break;
+    case 'n':
+      synth.devices = atoi(val);
+      break;
+    case 'r':
+      synth.rate = atoi(val);
+      break;
+    case 'd':
+      synth.duration = atoi(val);
+      break;
+    case 'b':
+      synth.ble = atoi(val);
+      break;
+    case 'R':
+      synth.random = atoi(val);
+      break;
+    case 'w':
+      synth.dwell = atoi(val);
+      break;
+    case 's':
+      synth.seed = atoi(val);
+      break;
+    case 'x':
+      speed = atof(val);
+      break;
+    case 'c':
+      sendcycle = atoi(val);
+      break;
+    case 'm':
+      countermode = atoi(val);
+      break;
+    case 'l':
+      rssilimit = atoi(val);
+      break;
+    case 'v':
+      host_loglevel = atoi(val);
+      break;
+    default:
+      usage();
+    }
+  }
+  if (!synth.devices || !synth.rate || !synth.dwell || (speed < 0))
+    usage();
+
+  FILE *f = NULL;
+  if (file) {
+    f = strcmp(file, "-") ? fopen(file, "r") : stdin;
+    if (!f) {
+      perror(file);
+      return 1;
+    }
+  } else
+    synth_init();
+
+  boot(countermode, sendcycle, rssilimit);
+
+  typedef std::chrono::steady_clock clock;
+  std::vector<double> latency; // [us] of sendData() per send cycle
+  uint64_t now = 0, fed = 0;
+  uint64_t nextCycle = cfg.sendcycle * 2 * 1000, nextHome = HOMECYCLE * 1000;
+  uint32_t lineno = 0, skipped = 0, unsorted = 0;
+  trace_t t;
+
+  // send cycle end: counts are final once the worker drained the rings
+  auto cycle = [&](uint64_t at) {
+    host_clock_set(at);
+    host_task_settle("sniffer");
+    libpax_host_cycle();
+    const clock::time_point t0 = clock::now();
+    sendData();
+    const double us =
+        std::chrono::duration<double, std::micro>(clock::now() - t0).count();
+    latency.push_back(us);
+    if (cycles)
+      printf("cycle %4zu %8llu s  pax %5u  wifi %5u  ble %5u  %8.1f us\n",
+             latency.size(), (unsigned long long)at / 1000,
+             count_from_libpax.pax, count_from_libpax.wifi_count,
+             count_from_libpax.ble_count, us);
+  };
+
+  const clock::time_point start = clock::now();
+  while (f ? file_next(f, &t, &lineno, &skipped) : synth_next(&t)) {
+    if (t.ms < now) {
+      unsorted++;
+      t.ms = now;
+    }
+    // send cycles and housekeeping due before this detection
+    for (;;) {
+      const uint64_t due = std::min(nextCycle, nextHome);
+      if (due > t.ms)
+        break;
+      if (due == nextCycle) {
+        cycle(due);
+        nextCycle += cfg.sendcycle * 2 * 1000;
+      } else {
+        host_clock_set(due);
+        station_update();
+        nextHome += HOMECYCLE * 1000;
+      }
+    }
+    if (speed > 0)
+      std::this_thread::sleep_until(
+          start + std::chrono::microseconds((uint64_t)(t.ms * 1000 / speed)));
+    now = t.ms;
+    host_clock_set(now);
+    feed(&t);
+    // unpaced the callbacks outrun the worker, let it catch up before the
+    // rings overflow
+    if (!(++fed % (SNIFF_RING_SLOTS / 2)) && (speed == 0))
+      host_task_settle("sniffer");
+  }
+  // the trace ends as before deep sleep, the worker drains the rings and ends
+  sniffer_stop();
+  const double wall =
+      std::chrono::duration<double>(clock::now() - start).count();
+  if (f && (f != stdin))
+    fclose(f);
+
+  uint32_t pushed[2], dropped[2];
+  sniffer_stats(pushed, dropped);
+  struct count_payload_t count;
+  get_paxcount(&count);
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+
+  std::sort(latency.begin(), latency.end());
+  double sum = 0;
+  for (double us : latency)
+    sum += us;
+
+  printf("detections  %llu in %.0f s trace time, %.3f s wall\n",
+         (unsigned long long)fed, now / 1000.0, wall);
+  printf("throughput  %.0f detections/s\n", wall > 0 ? fed / wall : 0);
+  const uint32_t rings = pushed[0] + pushed[1], lost = dropped[0] + dropped[1];
+  printf("worker      %u processed, %u dropped in full rings, %llu filtered\n",
+         rings, lost, (unsigned long long)(fed - rings - lost));
+  printf("send cycles %zu, sendData() us min %.1f / median %.1f / "
+         "p99 %.1f / max %.1f / mean %.1f\n",
+         latency.size(), percentile(latency, 0), percentile(latency, 0.5),
+         percentile(latency, 0.99), percentile(latency, 1),
+         latency.empty() ? 0 : sum / latency.size());
+  printf("count       pax %u / wifi %u / ble %u, mode %u\n", count.pax,
+         count.wifi_count, count.ble_count, cfg.countermode);
+  printf("memory      peak rss %ld kB, static data %lu kB, libpax %u MACs\n",
+         ru.ru_maxrss, (unsigned long)(&end - &__data_start) / 1024,
+         libpax_host_devices());
+  if (skipped || unsorted)
+    fprintf(stderr, "%u lines skipped, %u detections out of order\n", skipped,
+            unsorted);
+
+  // timer tasks never return, end without waiting for them
+  fflush(stdout);
+  _Exit(0);
+}
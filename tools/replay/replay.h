@@ -0,0 +1,20 @@
+#ifndef _REPLAY_H
+#define _REPLAY_H
+
+#include <stdint.h>
+
+// virtual clock of the replay, millis(), esp_timer_get_time() and uptime()
+// follow the trace timestamps
+void host_clock_set(uint64_t ms);
+
+// wakes the task of given name and waits until it blocks again, so all work
+// queued for it is done. Returns false if there is no such task.
+bool host_task_settle(const char *name);
+
+// end of a libpax send cycle, what the libpax report timer does on a device
+void libpax_host_cycle(void);
+
+// devices held by the libpax stand-in
+uint32_t libpax_host_devices(void);
+
+#endif
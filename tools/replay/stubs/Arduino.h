@@ -0,0 +1,120 @@
+// Host stand-in for the Arduino core and the parts of ESP-IDF and FreeRTOS
+// the counting path uses. Tasks are threads, critical sections are mutexes,
+// time is the virtual clock of the replay, see hostsys.cpp.
+
+#ifndef _HOST_ARDUINO_H
+#define _HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include <sys/time.h>
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+
+// attributes placing code and data in the ESP32 memory regions
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+
+// Arduino core
+typedef uint8_t byte;
+typedef bool boolean;
+using std::max;
+using std::min;
+#define highByte(w) ((uint8_t)((w) >> 8))
+#define lowByte(w) ((uint8_t)((w)&0xff))
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(uint32_t ms);
+
+class String : public std::string {
+public:
+  String() {}
+  String(const char *s) : std::string(s ? s : "") {}
+  String(const std::string &s) : std::string(s) {}
+  unsigned int length(void) const { return size(); }
+};
+
+// ESP-IDF
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+
+typedef enum { GPIO_NUM_NC = -1 } gpio_num_t;
+
+uint32_t esp_random(void);
+int64_t esp_timer_get_time(void);
+
+// logging, level of all tags is set at runtime by the replay
+#define ESP_LOG_NONE 0
+#define ESP_LOG_ERROR 1
+#define ESP_LOG_WARN 2
+#define ESP_LOG_INFO 3
+#define ESP_LOG_DEBUG 4
+#define ESP_LOG_VERBOSE 5
+
+extern int host_loglevel;
+void host_log(int level, const char *tag, const char *format, ...)
+    __attribute__((format(printf, 3, 4)));
+
+#define ESP_LOGE(tag, ...) host_log(ESP_LOG_ERROR, tag, __VA_ARGS__)
+#define ESP_LOGW(tag, ...) host_log(ESP_LOG_WARN, tag, __VA_ARGS__)
+#define ESP_LOGI(tag, ...) host_log(ESP_LOG_INFO, tag, __VA_ARGS__)
+#define ESP_LOGD(tag, ...) host_log(ESP_LOG_DEBUG, tag, __VA_ARGS__)
+#define ESP_LOGV(tag, ...) host_log(ESP_LOG_VERBOSE, tag, __VA_ARGS__)
+
+// FreeRTOS
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef struct hostTask *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+typedef void *SemaphoreHandle_t;
+typedef void *QueueHandle_t;
+typedef void *TimerHandle_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define pdFAIL 0
+#define portMAX_DELAY UINT32_MAX
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+typedef enum { eNoAction, eSetBits, eIncrement } eNotifyAction;
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t code, const char *name,
+                                   uint32_t stack, void *param,
+                                   UBaseType_t prio, TaskHandle_t *handle,
+                                   BaseType_t core);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t wait);
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+BaseType_t xTaskNotify(TaskHandle_t task, uint32_t value,
+                       eNotifyAction action);
+void vTaskDelay(TickType_t ticks);
+void vTaskDelete(TaskHandle_t task); // NULL only, ends the calling task
+
+// critical sections lock a mutex, recursive like the ESP32 spinlocks
+typedef struct {
+  std::recursive_mutex lock;
+} portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED                                           \
+  {}
+#define portENTER_CRITICAL(mux) (mux)->lock.lock()
+#define portEXIT_CRITICAL(mux) (mux)->lock.unlock()
+#define portENTER_CRITICAL_ISR(mux) portENTER_CRITICAL(mux)
+#define portEXIT_CRITICAL_ISR(mux) portEXIT_CRITICAL(mux)
+
+// hardware timer of the display and the led, never started here
+typedef struct hw_timer_s hw_timer_t;
+
+#endif
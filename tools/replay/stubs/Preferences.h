@@ -0,0 +1,26 @@
+// Host stand-in for the NVS preferences, always empty, so the firmware
+// starts with factory settings
+
+#ifndef _HOST_PREFERENCES_H
+#define _HOST_PREFERENCES_H
+
+#include <Arduino.h>
+
+class Preferences {
+public:
+  bool begin(const char *name, bool readOnly = false) { return false; }
+  void end(void) {}
+  bool clear(void) { return true; }
+  size_t putBytes(const char *key, const void *value, size_t len) {
+    return len;
+  }
+  size_t getBytes(const char *key, void *buf, size_t maxLen) { return 0; }
+  size_t putString(const char *key, const String &value) {
+    return value.length();
+  }
+  String getString(const char *key, const String &defaultValue = String()) {
+    return defaultValue;
+  }
+};
+
+#endif
@@ -0,0 +1,19 @@
+// Host stand-in for the Arduino Ticker, it never fires
+
+#ifndef _HOST_TICKER_H
+#define _HOST_TICKER_H
+
+#include <Arduino.h>
+
+class Ticker {
+public:
+  typedef void (*callback_t)(void);
+  void attach(float seconds, callback_t callback) {}
+  void attach_ms(uint32_t milliseconds, callback_t callback) {}
+  void once(float seconds, callback_t callback) {}
+  void once_ms(uint32_t milliseconds, callback_t callback) {}
+  void detach(void) {}
+  bool active(void) { return false; }
+};
+
+#endif
@@ -0,0 +1,76 @@
+// Host stand-in for the scanning part of the ESP-IDF BLE GAP API
+
+#ifndef _HOST_ESP_GAP_BLE_API_H
+#define _HOST_ESP_GAP_BLE_API_H
+
+#include <Arduino.h>
+
+typedef uint8_t esp_bd_addr_t[6];
+
+typedef enum {
+  ESP_GAP_BLE_SCAN_PARAM_SET_COMPLETE_EVT = 2,
+  ESP_GAP_BLE_SCAN_RESULT_EVT = 3,
+  ESP_GAP_BLE_SCAN_STOP_COMPLETE_EVT = 18
+} esp_gap_ble_cb_event_t;
+
+typedef enum {
+  ESP_GAP_SEARCH_INQ_RES_EVT = 0,
+  ESP_GAP_SEARCH_INQ_CMPL_EVT = 1
+} esp_gap_search_evt_t;
+
+typedef enum {
+  ESP_BLE_EVT_CONN_ADV = 0x00,
+  ESP_BLE_EVT_CONN_DIR_ADV = 0x01,
+  ESP_BLE_EVT_DISC_ADV = 0x02,
+  ESP_BLE_EVT_NON_CONN_ADV = 0x03,
+  ESP_BLE_EVT_SCAN_RSP = 0x04
+} esp_ble_evt_type_t;
+
+typedef enum {
+  BLE_ADDR_TYPE_PUBLIC = 0x00,
+  BLE_ADDR_TYPE_RANDOM = 0x01
+} esp_ble_addr_type_t;
+
+typedef enum {
+  BLE_SCAN_TYPE_PASSIVE = 0x0,
+  BLE_SCAN_TYPE_ACTIVE = 0x1
+} esp_ble_scan_type_t;
+
+typedef enum { BLE_SCAN_FILTER_ALLOW_ALL = 0x0 } esp_ble_scan_filter_t;
+
+typedef enum {
+  BLE_SCAN_DUPLICATE_DISABLE = 0x0,
+  BLE_SCAN_DUPLICATE_ENABLE = 0x1
+} esp_ble_scan_duplicate_t;
+
+typedef struct {
+  esp_ble_scan_type_t scan_type;
+  esp_ble_addr_type_t own_addr_type;
+  esp_ble_scan_filter_t scan_filter_policy;
+  uint16_t scan_interval;
+  uint16_t scan_window;
+  esp_ble_scan_duplicate_t scan_duplicate;
+} esp_ble_scan_params_t;
+
+typedef union {
+  struct ble_scan_result_evt_param {
+    esp_gap_search_evt_t search_evt;
+    esp_bd_addr_t bda;
+    esp_ble_evt_type_t ble_evt_type;
+    esp_ble_addr_type_t ble_addr_type;
+    int rssi;
+  } scan_rst;
+} esp_ble_gap_cb_param_t;
+
+typedef void (*esp_gap_ble_cb_t)(esp_gap_ble_cb_event_t event,
+                                 esp_ble_gap_cb_param_t *param);
+
+esp_err_t esp_ble_gap_register_callback(esp_gap_ble_cb_t callback);
+esp_err_t esp_ble_gap_set_scan_params(esp_ble_scan_params_t *scan_params);
+esp_err_t esp_ble_gap_start_scanning(uint32_t duration);
+esp_err_t esp_ble_gap_stop_scanning(void);
+
+// replay side: callback registered by the firmware, NULL if none
+extern esp_gap_ble_cb_t host_ble_cb;
+
+#endif
@@ -0,0 +1,42 @@
+// Host stand-in for the promiscuous mode part of the ESP-IDF wifi driver
+
+#ifndef _HOST_ESP_WIFI_H
+#define _HOST_ESP_WIFI_H
+
+#include <Arduino.h>
+
+typedef enum {
+  WIFI_PKT_MGMT,
+  WIFI_PKT_CTRL,
+  WIFI_PKT_DATA,
+  WIFI_PKT_MISC
+} wifi_promiscuous_pkt_type_t;
+
+typedef enum {
+  WIFI_SECOND_CHAN_NONE,
+  WIFI_SECOND_CHAN_ABOVE,
+  WIFI_SECOND_CHAN_BELOW
+} wifi_second_chan_t;
+
+typedef struct {
+  signed rssi : 8;
+  unsigned channel : 4;
+  unsigned sig_len : 12;
+} wifi_pkt_rx_ctrl_t;
+
+typedef struct {
+  wifi_pkt_rx_ctrl_t rx_ctrl;
+  uint8_t payload[0];
+} wifi_promiscuous_pkt_t;
+
+typedef void (*wifi_promiscuous_cb_t)(void *buf,
+                                      wifi_promiscuous_pkt_type_t type);
+
+esp_err_t esp_wifi_set_promiscuous(bool en);
+esp_err_t esp_wifi_set_promiscuous_rx_cb(wifi_promiscuous_cb_t cb);
+esp_err_t esp_wifi_set_channel(uint8_t primary, wifi_second_chan_t second);
+
+// replay side: callback registered by the firmware, NULL if none
+extern wifi_promiscuous_cb_t host_wifi_cb;
+
+#endif
@@ -0,0 +1,39 @@
+// Host stand-in for the libpax API, implemented by libpax.cpp of the replay
+
+#ifndef _HOST_LIBPAX_API_H
+#define _HOST_LIBPAX_API_H
+
+#include <stdint.h>
+
+#define WIFI_CHANNEL_ALL 0b1111111111111
+
+struct count_payload_t {
+  uint32_t pax;
+  uint32_t wifi_count;
+  uint32_t ble_count;
+};
+
+struct libpax_config_t {
+  char wifi_my_country_str[3];
+  uint8_t wificounter;
+  uint16_t wifi_channel_map;
+  uint16_t wifi_channel_switch_interval;
+  int wifi_rssi_threshold;
+  uint8_t blecounter;
+  uint8_t blescantime;
+  uint16_t blescanwindow;
+  uint16_t blescaninterval;
+  int ble_rssi_threshold;
+};
+
+void libpax_default_config(struct libpax_config_t *configuration);
+int libpax_update_config(struct libpax_config_t *configuration);
+void libpax_get_current_config(struct libpax_config_t *configuration);
+int libpax_counter_init(void (*callback)(void),
+                        struct count_payload_t *pax_count_storage,
+                        uint16_t pax_report_interval_sec, int countermode);
+int libpax_counter_start(void);
+int libpax_counter_stop(void);
+int libpax_counter_count(struct count_payload_t *count);
+
+#endif
@@ -0,0 +1,10 @@
+// Host stand-in for the CRC routines in the ESP32 ROM
+
+#ifndef _HOST_ROM_CRC_H
+#define _HOST_ROM_CRC_H
+
+#include <stdint.h>
+
+uint32_t crc32_le(uint32_t crc, const uint8_t *buf, uint32_t len);
+
+#endif
@@ -0,0 +1,6 @@
+// Host stand-in, nothing of it is used by the counting path
+
+#ifndef _HOST_SOC_RESET_REASONS_H
+#define _HOST_SOC_RESET_REASONS_H
+
+#endif
@@ -0,0 +1,157 @@
+// sketchmerge - unique device count of a site with overlapping paxcounters
+//
+// Merges sketches exported on SKETCHPORT by any number of devices into one
+// union sketch and prints its estimate next to the per device estimates and
+// their sum, which counts devices seen by several paxcounters repeatedly.
+// All devices of a site need the same site key, set by rcommand 0x25.
+//
+// Input, from files or stdin: one packet per line as hex, optionally after
+// a device name and a space. Packets of the sketches of one send cycle are
+// selected with -s <stamp>, the cycle stamp in their header, which devices
+// with the same send cycle and a synced clock share. Empty lines and lines
+// starting with # are skipped.
+//
+// build: g++ -std=gnu++17 -O2 -Iinclude -o sketchmerge tools/sketchmerge.cpp
+//        src/sketchcodec.cpp src/hyperloglog.cpp
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "hyperloglog.h"
+#include "sketchcodec.h"
+
+typedef struct {
+  std::vector<uint8_t> regs;
+  uint32_t packets = 0;
+  uint32_t covered = 0; // registers received
+} device_t;
+
+static int hexval(char c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  c |= 0x20;
+  return (c >= 'a' && c <= 'f') ? c - 'a' + 10 : -1;
+}
+
+// hex string to bytes, false on odd length or non hex characters
+static bool parse_hex(const char *s, std::vector<uint8_t> &out) {
+  out.clear();
+  while (*s && !strchr("\r\n", *s)) {
+    const int hi = hexval(s[0]), lo = s[1] ? hexval(s[1]) : -1;
+    if (hi < 0 || lo < 0)
+      return false;
+    out.push_back(hi << 4 | lo);
+    s += 2;
+  }
+  return !out.empty();
+}
+
+static void usage(void) {
+  fprintf(stderr, "usage: sketchmerge [-s stamp] [file ...]\n");
+  exit(2);
+}
+
+int main(int argc, char **argv) {
+  int precision = -1;
+  bool select = false;
+  uint32_t stamp = 0;
+  std::vector<const char *> files;
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+      stamp = strtoul(argv[++i], NULL, 0);
+      select = true;
+    }
+    else if (argv[i][0] == '-' && argv[i][1])
+      usage();
+    else
+      files.push_back(argv[i]);
+  }
+  if (files.empty())
+    files.push_back("-");
+
+  std::map<std::string, device_t> devices;
+  std::set<uint32_t> stamps;
+  std::vector<uint8_t> pkt;
+  char line[1024];
+  uint32_t lineno = 0, skipped = 0;
+
+  for (const char *name : files) {
+    FILE *f = strcmp(name, "-") ? fopen(name, "r") : stdin;
+    if (!f) {
+      perror(name);
+      return 1;
+    }
+    while (fgets(line, sizeof(line), f)) {
+      lineno++;
+      if (line[0] == '#' || line[0] == '\n' || line[0] == '\r')
+        continue;
+      char *hex = strchr(line, ' ');
+      const std::string dev = hex ? std::string(line, hex - line) : "-";
+      hex = hex ? hex + 1 : line;
+
+      sketchHeader_t h;
+      if (!parse_hex(hex, pkt) || !sketch_header(pkt.data(), pkt.size(), &h)) {
+        fprintf(stderr, "line %u: malformed packet, skipped\n", lineno);
+        skipped++;
+        continue;
+      }
+      if (select && (h.stamp != stamp))
+        continue;
+      if (precision < 0)
+        precision = h.precision;
+      if (h.precision != precision) {
+        fprintf(stderr, "line %u: precision %u, not %d, skipped\n", lineno,
+                h.precision, precision);
+        skipped++;
+        continue;
+      }
+
+      stamps.insert(h.stamp);
+      device_t &d = devices[dev];
+      if (d.regs.empty())
+        d.regs.assign(1U << precision, 0);
+      sketch_merge(pkt.data(), pkt.size(), d.regs.data(), precision);
+      d.packets++;
+      d.covered += h.count;
+    }
+    if (f != stdin)
+      fclose(f);
+  }
+
+  if (devices.empty()) {
+    fprintf(stderr, "no sketches\n");
+    return 1;
+  }
+
+  // union of all devices, registers merge by maximum
+  std::vector<uint8_t> all(1U << precision, 0);
+  HyperLogLog merged(all.data(), precision, true);
+  uint32_t sum = 0;
+  for (auto &it : devices) {
+    HyperLogLog hll(it.second.regs.data(), precision, true);
+    merged.merge(hll);
+    const uint32_t e = hll.estimate();
+    sum += e;
+    printf("%-20s %8u devices  %3u packets%s\n", it.first.c_str(), e,
+           it.second.packets,
+           (it.second.covered < hll.size()) ? "  (incomplete)" : "");
+  }
+
+  printf("%-20s %8u devices\n", "sum", sum);
+  printf("%-20s %8u devices  +/- %.1f%%\n", "union", merged.estimate(),
+         100.0f * merged.stderror());
+  if (skipped)
+    fprintf(stderr, "%u packets skipped\n", skipped);
+  if (stamps.size() > 1)
+    fprintf(stderr, "sketches of %zu cycles merged, select one with -s\n",
+            stamps.size());
+  else if (!*stamps.begin())
+    fprintf(stderr, "sketches without cycle stamp, device clocks unsynced\n");
+  return 0;
+}